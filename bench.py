@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""Here you can find the benchmark driver of the solver, which replaces editing run.sh and reading the output files by hand.
+
+It sweeps the side length n, the line sum M, the precomputed row, the number of processes and the number of threads.
+Every configuration is run several times with mpiexec on the local machine, oversubscribing the cores if needed.
+The sequential solver is run for every n, M and precomputed row as the baseline of the speedup and the efficiency.
+The number of solutions of every run is compared to the baseline, so a change which breaks the search is caught as well.
+The expanded nodes are compared as well where they can't differ: when all solutions are searched without looking up remaining boards, and the sequential solver has work units too.
+The results are printed as a table and can be written as JSON and CSV.
+
+Example:
+    python3 bench.py --build --n 3 --rows 0 1 --procs 1 2 4 --threads 1 2 --repeat 5 --json bench.json --csv bench.csv
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+
+# The build command of the README
+BUILD_COMMAND = "mpicc -g -Wall -fopenmp -o {solver} solver.c helpers.c board.c search.c schedule.c prefix.c checkpoint.c results.c stats.c sink.c lines.c meet.c memo.c estimate.c shared.c"
+
+# The lines of the solver output the results are read from
+TIME_PATTERN = re.compile(r"This took ([0-9.]+) seconds")
+SOLUTIONS_PATTERN = re.compile(r"The solver found (\d+) solutions")
+NODES_PATTERN = re.compile(r"expanded (\d+) nodes")
+
+
+def default_line_sum(n, start):
+    """This function returns the only line sum a hexagon of side length n with the values start, start + 1, ... can have, or None if there is none."""
+    cells = 3 * n * n - 3 * n + 1
+    rows = 2 * n - 1
+    total = cells * (2 * start + cells - 1) // 2
+    return total // rows if total % rows == 0 else None
+
+
+def option_value(solver_args, option):
+    """This function returns the value the last occurrence of a short option of the solver sets, or None if it isn't given."""
+    value = None
+    for i, arg in enumerate(solver_args):
+        if arg.startswith(option):
+            value = arg[len(option):] or (solver_args[i + 1] if i + 1 < len(solver_args) else None)
+    return value
+
+
+def nodes_must_match(solver_args, row):
+    """This function returns whether a parallel run has to expand exactly as many nodes as the sequential one.
+    A search for the first solution stops at different points, and the hits of the tables of remaining boards depend on the order of the work units.
+    Without precomputed rows the sequential search engines solve the whole board at once and also count the values of the first tile, which the work units of the parallel solver set in advance.
+    """
+    if int(option_value(solver_args, "-a") or 0) == 0 or int(option_value(solver_args, "-m") or 0) > 0:
+        return False
+    return row != -1 or int(option_value(solver_args, "-e") or 0) == 3
+
+
+def parse_arguments():
+    """This function reads the command line arguments of the driver."""
+    parser = argparse.ArgumentParser(description="Run scaling sweeps of the magic hexagon solver and summarize them.")
+    parser.add_argument("--solver", default="./solver.o", help="the solver executable")
+    parser.add_argument("--build", action="store_true", help="build the solver with the command of the README first")
+    parser.add_argument("--n", type=int, nargs="+", default=[3], help="side lengths of the hexagon")
+    parser.add_argument("--s", type=int, default=1, help="the smallest value placed on the board")
+    parser.add_argument("--M", type=int, nargs="+", default=None, help="line sums, by default the only feasible one of each n")
+    parser.add_argument("--rows", type=int, nargs="+", default=[0], help="precomputed rows (-r), -1 for none and -2 for the search frontier")
+    parser.add_argument("--procs", type=int, nargs="+", default=[1, 2, 4], help="numbers of MPI processes")
+    parser.add_argument("--threads", type=int, nargs="+", default=[1], help="numbers of OpenMP threads per process")
+    parser.add_argument("--repeat", type=int, default=3, help="runs of every configuration")
+    parser.add_argument("--args", default="-a 1", help="further arguments passed to every run of the solver")
+    parser.add_argument("--mpiexec", default="mpiexec", help="the command which starts the parallel runs, Open MPI is told to oversubscribe the cores")
+    parser.add_argument("--timeout", type=float, default=600, help="seconds after which a run is aborted")
+    parser.add_argument("--json", help="write the results to this JSON file")
+    parser.add_argument("--csv", help="write the results to this CSV file")
+    return parser.parse_args()
+
+
+def run_solver(command, threads, timeout):
+    """This function runs the solver once and returns its runtime, number of solutions and expanded nodes."""
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    result = subprocess.run(command, env=env, capture_output=True, text=True, timeout=timeout)
+    if result.returncode != 0:
+        raise RuntimeError("{} failed with exit code {}:\n{}{}".format(shlex.join(command), result.returncode, result.stdout, result.stderr))
+    time = TIME_PATTERN.search(result.stdout)
+    if time is None:
+        raise RuntimeError("{} didn't report its runtime:\n{}".format(shlex.join(command), result.stdout))
+    solutions = SOLUTIONS_PATTERN.search(result.stdout)
+    nodes = NODES_PATTERN.search(result.stdout)
+    return float(time.group(1)), int(solutions.group(1)) if solutions else None, int(nodes.group(1)) if nodes else None
+
+
+def run_configuration(args, solver_args, procs, threads):
+    """This function runs a configuration repeatedly and summarizes the runs. Without a number of processes the sequential solver is run."""
+    if procs is None:
+        command = [args.solver, "-p0"] + solver_args
+    else:
+        command = shlex.split(args.mpiexec) + ["-n", str(procs), args.solver, "-p1"] + solver_args
+    times = []
+    solutions = nodes = None
+    for _ in range(args.repeat):
+        time, solutions, nodes = run_solver(command, threads, args.timeout)
+        times.append(time)
+    return {
+        "command": shlex.join(command),
+        "times": times,
+        "median": statistics.median(times),
+        "min": min(times),
+        "max": max(times),
+        "solutions": solutions,
+        "nodes": nodes,
+    }
+
+
+def main():
+    """This function runs the sweep, compares every configuration with its sequential baseline and writes the results."""
+    args = parse_arguments()
+    if args.build:
+        subprocess.run(shlex.split(BUILD_COMMAND.format(solver=args.solver)), check=True)
+    # The mpiexec of Open MPI refuses to start more processes than cores or to run as root unless told otherwise, other implementations don't know these flags
+    version = subprocess.run(shlex.split(args.mpiexec)[:1] + ["--version"], capture_output=True, text=True).stdout
+    if "open-mpi" in version or "OpenRTE" in version or "Open MPI" in version:
+        if "--oversubscribe" not in args.mpiexec:
+            args.mpiexec += " --oversubscribe"
+        if os.geteuid() == 0 and "--allow-run-as-root" not in args.mpiexec:
+            args.mpiexec += " --allow-run-as-root"
+
+    results = []
+    mismatches = 0
+    print("{:>2} {:>4} {:>4} {:>5} {:>7} {:>10} {:>10} {:>10} {:>8} {:>10}".format("n", "M", "r", "procs", "threads", "median", "min", "max", "speedup", "efficiency"))
+    for n in args.n:
+        line_sums = args.M if args.M is not None else [default_line_sum(n, args.s)]
+        for M in line_sums:
+            if M is None:
+                print("n = {} has no feasible line sum for s = {}, skipped.".format(n, args.s))
+                continue
+            for row in args.rows:
+                solver_args = ["-n", str(n), "-s{}".format(args.s), "-M", str(M), "-r{}".format(row)] + shlex.split(args.args)
+                baseline = run_configuration(args, solver_args, None, 1)
+                compare_nodes = nodes_must_match(solver_args, row)
+                configurations = [(None, 1, baseline)]
+                for procs in args.procs:
+                    for threads in args.threads:
+                        configurations.append((procs, threads, run_configuration(args, solver_args, procs, threads)))
+
+                for procs, threads, run in configurations:
+                    workers = (procs or 1) * threads
+                    run.update({
+                        "n": n, "s": args.s, "M": M, "row": row,
+                        "procs": procs or 0, "threads": threads,
+                        "speedup": baseline["median"] / run["median"] if run["median"] > 0 else None,
+                    })
+                    run["efficiency"] = run["speedup"] / workers if run["speedup"] is not None else None
+                    # The parallel runs have to find what the sequential one found, and expand as many nodes where they can't differ
+                    differences = []
+                    if run["solutions"] != baseline["solutions"]:
+                        differences.append("solutions differ: {} instead of {}".format(run["solutions"], baseline["solutions"]))
+                    if compare_nodes and run["nodes"] != baseline["nodes"]:
+                        differences.append("nodes differ: {} instead of {}".format(run["nodes"], baseline["nodes"]))
+                    run["matches_baseline"] = not differences
+                    if not run["matches_baseline"]:
+                        mismatches += 1
+                    results.append(run)
+                    print("{:>2} {:>4} {:>4} {:>5} {:>7} {:>10.4f} {:>10.4f} {:>10.4f} {:>8.2f} {:>10.2f}{}".format(
+                        n, M, row, procs if procs else "seq", threads, run["median"], run["min"], run["max"],
+                        run["speedup"] or 0, run["efficiency"] or 0,
+                        "".join("  " + difference for difference in differences)))
+
+    if args.json:
+        with open(args.json, "w") as file:
+            json.dump(results, file, indent=2)
+    if args.csv:
+        fields = ["n", "s", "M", "row", "procs", "threads", "median", "min", "max", "speedup", "efficiency", "solutions", "nodes", "matches_baseline", "command"]
+        with open(args.csv, "w", newline="") as file:
+            writer = csv.DictWriter(file, fieldnames=fields, extrasaction="ignore")
+            writer.writeheader()
+            writer.writerows(results)
+    if mismatches > 0:
+        print("{} runs found a different number of solutions or expanded a different number of nodes than the sequential solver!".format(mismatches))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
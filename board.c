@@ -0,0 +1,231 @@
+/*Here you can find the flat board representation of the solver.
+Instead of a sparse r x r x r cube, the board is stored as a dense array of the N tiles in row-major order of the first diagonal.
+The lines each tile is part of and the tiles each line consists of are precomputed once, so the solver never has to calculate coordinates while searching.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "board.h"
+#include "helpers.h"
+
+bool init_board_layout(board_layout *layout, int n){
+    /* This function precomputes the tables of the flat board representation for a hexagon of side length n.
+    It returns false if the hexagon is too large to be represented.
+    */
+    if (n < 1 || n > HEX_MAX_N){
+        return false;
+    }
+    int r = n*2-1;
+    int N = 3*n*n-3*n+1;
+    int i, j, k, row_length;
+    layout->n = n;
+    layout->r = r;
+    layout->N = N;
+    layout->nr_lines = 3*r;
+
+    // This array maps the cube coordinates back to the index of the tile
+    int cell_index[r][r][r];
+    int a[r][3];
+
+    // Number the tiles in row-major order of the first diagonal, which is the order fill_board uses
+    int cell = 0;
+    for (i = 0; i < r; i++){
+        row_length = r-abs(n-1-i);
+        get_coordinates_of_row(a, 0, i, n);
+        layout->row_start[i] = cell;
+        for (j = 0; j < row_length; j++){
+            for (k = 0; k < 3; k++){
+                layout->cell_coords[cell][k] = a[j][k];
+            }
+            cell_index[a[j][0]][a[j][1]][a[j][2]] = cell;
+            cell++;
+        }
+    }
+
+    // Collect the tiles of each row in each diagonal
+    int line, offset = 0;
+    for (i = 0; i < 3; i++){
+        for (j = 0; j < r; j++){
+            line = i*r + j;
+            row_length = r-abs(n-1-j);
+            get_coordinates_of_row(a, i, j, n);
+            layout->line_length[line] = row_length;
+            layout->line_start[line] = offset;
+            for (k = 0; k < row_length; k++){
+                cell = cell_index[a[k][0]][a[k][1]][a[k][2]];
+                layout->line_cells[offset + k] = cell;
+                layout->cell_lines[cell][i] = line;
+            }
+            offset += row_length;
+        }
+    }
+
+    // Rotate and reflect each cell around the center. With c = x - (n-1) etc. a rotation by 60 degrees maps (a, b, c) to (-b, -c, -a) and a reflection swaps b and c.
+    int g, rot, c[3], t;
+    for (g = 0; g < HEX_SYMMETRIES; g++){
+        for (cell = 0; cell < N; cell++){
+            for (k = 0; k < 3; k++){
+                c[k] = layout->cell_coords[cell][k] - (n-1);
+            }
+            if (g >= 6){
+                t = c[1];
+                c[1] = c[2];
+                c[2] = t;
+            }
+            for (rot = 0; rot < g % 6; rot++){
+                t = c[0];
+                c[0] = -c[1];
+                c[1] = -c[2];
+                c[2] = -t;
+            }
+            layout->symmetries[g][cell] = cell_index[c[0] + n-1][c[1] + n-1][c[2] + n-1];
+        }
+    }
+
+    // The first cell is a corner, rotating it gives the other five
+    for (cell = 0; cell < N; cell++){
+        layout->corner_of[cell] = -1;
+    }
+    for (k = 0; k < 6; k++){
+        layout->corners[k] = layout->symmetries[k][0];
+        layout->corner_of[layout->corners[k]] = k;
+    }
+    return true;
+}
+
+void print_flat_board(const board_layout *layout, const int *cells){
+    /* This function prints out the given flat board to the console in the same format as print_board.
+    */
+    int i, j, k, diff, row_length;
+    int r = layout->r;
+    printf("\n");
+    // Loop over each row of the first diagonal
+    for (i = 0; i < r; i++){
+        row_length = layout->line_length[i];
+        diff = r - row_length;
+        // Print leading spaces
+        for (k = 0; k < diff; k++){
+            printf("  ");
+        }
+        // The rows of the first diagonal are stored consecutively
+        for (j = 0; j < row_length; j++){
+            printf("%02d  ", cells[layout->row_start[i] + j]);
+        }
+        // Print trailing spaces
+        for (k = 0; k < diff - 1; k++){
+            printf("  ");
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+bool validate_flat_board(const board_layout *layout, const int *cells, int M){
+    /* This function checks for each line of the flat board if it sums up to M.
+    */
+    int i, k, total;
+    const unsigned char *line_cells;
+
+    for (i = 0; i < layout->nr_lines; i++){
+        total = 0;
+        line_cells = layout->line_cells + layout->line_start[i];
+        for (k = 0; k < layout->line_length[i]; k++){
+            total += cells[line_cells[k]];
+        }
+        if (total != M){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool validate_flat_tile(const board_layout *layout, const int *cells, int M, int cell){
+    /* This function checks whether a newly placed tile is keeping the flat board valid by checking the three lines the tile is in.
+    */
+    int i, k, total, board_val, line;
+    bool all_set;
+    const unsigned char *line_cells;
+
+    for (i = 0; i < 3; i++){
+        total = 0;
+        all_set = true;
+        line = layout->cell_lines[cell][i];
+        line_cells = layout->line_cells + layout->line_start[line];
+        for (k = 0; k < layout->line_length[line]; k++){
+            board_val = cells[line_cells[k]];
+            // Check if only partial solution in the line
+            if (board_val == 0)
+                all_set = false;
+            else
+                total += board_val;
+        }
+
+        // Check if sum is equal to M if all values were set, otherwise just check if not larger than M
+        if ((all_set && total != M) || total > M){
+            return false;
+        }
+    }
+    return true;
+}
+
+int count_symmetric_boards(const board_layout *layout, const int *cells){
+    /* This function counts the distinct boards obtained by rotating and reflecting the given board.
+    With distinct values this is 12 for every board except the single tile of n = 1.
+    */
+    int images[HEX_SYMMETRIES][HEX_MAX_CELLS];
+    int g, h, i, cnt = 0;
+    bool duplicated;
+    for (g = 0; g < HEX_SYMMETRIES; g++){
+        for (i = 0; i < layout->N; i++){
+            images[g][layout->symmetries[g][i]] = cells[i];
+        }
+        // Only count the image if no previous symmetry produced the same board
+        duplicated = false;
+        for (h = 0; h < g && !duplicated; h++){
+            duplicated = true;
+            for (i = 0; i < layout->N; i++){
+                if (images[g][i] != images[h][i]){
+                    duplicated = false;
+                    break;
+                }
+            }
+        }
+        if (!duplicated)
+            cnt++;
+    }
+    return cnt;
+}
+
+int feasible_line_sum(int n, int N_s){
+    /* This function returns the only sum M the lines of a solution can have, or -1 if there is none.
+    The r lines of one diagonal cover every tile exactly once, so r * M has to be the sum of all values N_s, ..., N_s + N - 1.
+    */
+    int r = 2*n-1;
+    int N = 3*n*n-3*n+1;
+    long long total = (long long)N * N_s + (long long)N * (N - 1) / 2;
+    if (total % r != 0)
+        return -1;
+    return total / r;
+}
+
+void canonical_board(const board_layout *layout, const int *cells, int *canonical){
+    /* This function stores the lexicographically smallest of the boards obtained by rotating and reflecting the given board in canonical.
+    All boards of a set of symmetric boards have the same canonical board.
+    */
+    int image[HEX_MAX_CELLS];
+    int g, i;
+    memcpy(canonical, cells, layout->N * sizeof(int));
+    for (g = 1; g < HEX_SYMMETRIES; g++){
+        for (i = 0; i < layout->N; i++){
+            image[layout->symmetries[g][i]] = cells[i];
+        }
+        // Find the first tile in which the boards differ
+        for (i = 0; i < layout->N && image[i] == canonical[i]; i++);
+        if (i < layout->N && image[i] < canonical[i])
+            memcpy(canonical, image, layout->N * sizeof(int));
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdbool.h>
+
+// Largest side length the flat board representation supports
+#define HEX_MAX_N 7
+// Derived maximum sizes of the flat board representation
+#define HEX_MAX_ROWS (2*HEX_MAX_N-1)
+#define HEX_MAX_CELLS (3*HEX_MAX_N*HEX_MAX_N-3*HEX_MAX_N+1)
+#define HEX_MAX_LINES (3*HEX_MAX_ROWS)
+// Number of rotations and reflections of a hexagon
+#define HEX_SYMMETRIES 12
+
+// Precomputed, immutable tables describing the flat board representation.
+// Cells are numbered in row-major order of the first diagonal and line l = diagonal * r + row.
+typedef struct {
+    int n, r, N, nr_lines;
+    // Index of the first cell of each row of the first diagonal
+    unsigned char row_start[HEX_MAX_ROWS];
+    // The line of each diagonal the cell is in
+    unsigned char cell_lines[HEX_MAX_CELLS][3];
+    // The cube coordinates of each cell in the r x r x r representation
+    unsigned char cell_coords[HEX_MAX_CELLS][3];
+    // Number of cells in each line and offset of its first cell in line_cells
+    unsigned char line_length[HEX_MAX_LINES];
+    unsigned short line_start[HEX_MAX_LINES];
+    // The cells of all lines stored one after another
+    unsigned char line_cells[3*HEX_MAX_CELLS];
+    // The image of each cell under the 12 rotations and reflections of the hexagon, the first six are the rotations
+    unsigned char symmetries[HEX_SYMMETRIES][HEX_MAX_CELLS];
+    // The six corners in the order of the rotations starting at the first cell, and for each cell which corner it is (-1 if none)
+    unsigned char corners[6];
+    signed char corner_of[HEX_MAX_CELLS];
+} board_layout;
+
+bool init_board_layout(board_layout *layout, int n);
+
+void print_flat_board(const board_layout *layout, const int *cells);
+
+bool validate_flat_board(const board_layout *layout, const int *cells, int M);
+
+bool validate_flat_tile(const board_layout *layout, const int *cells, int M, int cell);
+
+int count_symmetric_boards(const board_layout *layout, const int *cells);
+
+int feasible_line_sum(int n, int N_s);
+
+void canonical_board(const board_layout *layout, const int *cells, int *canonical);
+
+#endif
@@ -0,0 +1,145 @@
+/*Here you can find the checkpoints of long running searches, which allow to resume them after the job was killed.
+A checkpoint stores the parameters of the search, the results of the completed work units and the indexes of the completed work units as ranges of consecutive indexes.
+It is written to a temporary file first, which then replaces the previous checkpoint, so a job killed while writing never leaves a broken checkpoint behind.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "checkpoint.h"
+
+// First line of every checkpoint file
+#define CHECKPOINT_HEADER "magic-hexagon checkpoint 1"
+
+void init_checkpoint(checkpoint *cp, const char *path, int interval, const int *params){
+    /* This function initializes a checkpoint without completed work units, which is written to path every interval seconds.
+    */
+    cp->path = path;
+    cp->interval = interval;
+    cp->last_write = time(NULL);
+    memcpy(cp->params, params, CHECKPOINT_PARAMS * sizeof(int));
+    cp->done = NULL;
+    cp->capacity = 0;
+    cp->done_cnt = 0;
+    cp->sol_cnt = 0;
+    cp->sol_expanded = 0;
+    cp->nodes = 0;
+}
+
+bool unit_done(const checkpoint *cp, long long index){
+    /* This function returns whether the work unit with the given index is completed.
+    */
+    if (index >= cp->capacity)
+        return false;
+    return cp->done[index / 8] & (1 << (index % 8));
+}
+
+void complete_unit(checkpoint *cp, long long index){
+    /* This function marks the work unit with the given index as completed and grows the bitmap if needed.
+    */
+    if (index >= cp->capacity){
+        long long capacity = cp->capacity > 0 ? cp->capacity : 1024;
+        while (capacity <= index){
+            capacity *= 2;
+        }
+        cp->done = realloc(cp->done, capacity / 8);
+        if (cp->done == NULL){
+            printf("Could not allocate memory for the checkpoint of %lld work units!\n", capacity);
+            exit(-1);
+        }
+        memset(cp->done + cp->capacity / 8, 0, (capacity - cp->capacity) / 8);
+        cp->capacity = capacity;
+    }
+    if (!unit_done(cp, index)){
+        cp->done[index / 8] |= 1 << (index % 8);
+        cp->done_cnt++;
+    }
+}
+
+void add_checkpoint_results(checkpoint *cp, long long sol_cnt, long long sol_expanded, long long nodes){
+    /* This function adds the results of completed work units.
+    */
+    cp->sol_cnt += sol_cnt;
+    cp->sol_expanded += sol_expanded;
+    cp->nodes += nodes;
+}
+
+checkpoint_status load_checkpoint(checkpoint *cp){
+    /* This function reads the checkpoint from its file and returns whether there is none, it was loaded or it was written with other parameters.
+    */
+    int k, param;
+    long long first, last, i;
+    char header[64];
+    FILE *file = fopen(cp->path, "r");
+    if (file == NULL)
+        return CHECKPOINT_MISSING;
+
+    bool ok = fgets(header, sizeof(header), file) != NULL && strncmp(header, CHECKPOINT_HEADER, strlen(CHECKPOINT_HEADER)) == 0;
+    for (k = 0; ok && k < CHECKPOINT_PARAMS; k++){
+        ok = fscanf(file, "%d", &param) == 1 && param == cp->params[k];
+    }
+    ok = ok && fscanf(file, "%lld %lld %lld", &cp->sol_cnt, &cp->sol_expanded, &cp->nodes) == 3;
+    // The ranges of completed work units follow until the end of the file
+    while (ok && fscanf(file, "%lld %lld", &first, &last) == 2){
+        for (i = first; i <= last; i++){
+            complete_unit(cp, i);
+        }
+    }
+    fclose(file);
+    if (!ok){
+        cp->sol_cnt = 0;
+        cp->sol_expanded = 0;
+        cp->nodes = 0;
+        return CHECKPOINT_MISMATCH;
+    }
+    return CHECKPOINT_LOADED;
+}
+
+void update_checkpoint(checkpoint *cp, bool force){
+    /* This function writes the checkpoint if interval seconds passed since it was last written or if forced to.
+    */
+    int k;
+    long long i, first;
+    if (cp->path == NULL)
+        return;
+    time_t now = time(NULL);
+    if (!force && now - cp->last_write < cp->interval)
+        return;
+    cp->last_write = now;
+
+    char tmp_path[strlen(cp->path) + 5];
+    sprintf(tmp_path, "%s.tmp", cp->path);
+    FILE *file = fopen(tmp_path, "w");
+    if (file == NULL){
+        printf("Could not write the checkpoint %s!\n", tmp_path);
+        return;
+    }
+    fprintf(file, "%s\n", CHECKPOINT_HEADER);
+    for (k = 0; k < CHECKPOINT_PARAMS; k++){
+        fprintf(file, "%d%c", cp->params[k], k < CHECKPOINT_PARAMS - 1 ? ' ' : '\n');
+    }
+    fprintf(file, "%lld %lld %lld\n", cp->sol_cnt, cp->sol_expanded, cp->nodes);
+    // Write the completed work units as ranges of consecutive indexes
+    for (i = 0; i < cp->capacity; i++){
+        if (!unit_done(cp, i))
+            continue;
+        first = i;
+        while (i + 1 < cp->capacity && unit_done(cp, i + 1)){
+            i++;
+        }
+        fprintf(file, "%lld %lld\n", first, i);
+    }
+    fclose(file);
+    rename(tmp_path, cp->path);
+}
+
+void free_checkpoint(checkpoint *cp){
+    /* This function releases the memory of the bitmap of completed work units.
+    */
+    free(cp->done);
+    cp->done = NULL;
+    cp->capacity = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <time.h>
+
+// Number of solver parameters which have to match when resuming from a checkpoint
+#define CHECKPOINT_PARAMS 12
+
+// What was found when loading a checkpoint
+typedef enum {
+    CHECKPOINT_MISSING,
+    CHECKPOINT_LOADED,
+    // The file was written with other parameters or is damaged, so it must neither be used nor overwritten
+    CHECKPOINT_MISMATCH
+} checkpoint_status;
+
+// The progress of a search over a stream of work units, which is written to a file from time to time.
+// Work units are identified by their index in the stream, which is the same on every run with the same parameters.
+typedef struct {
+    // The file the checkpoint is written to, NULL if none is written
+    const char *path;
+    // Seconds between two checkpoints and the time of the last one
+    int interval;
+    time_t last_write;
+    // The parameters the work units depend on
+    int params[CHECKPOINT_PARAMS];
+    // Bitmap of the completed work units and its size in units
+    unsigned char *done;
+    long long capacity, done_cnt;
+    // Results of the completed work units
+    long long sol_cnt, sol_expanded, nodes;
+} checkpoint;
+
+void init_checkpoint(checkpoint *cp, const char *path, int interval, const int *params);
+
+checkpoint_status load_checkpoint(checkpoint *cp);
+
+bool unit_done(const checkpoint *cp, long long index);
+
+void complete_unit(checkpoint *cp, long long index);
+
+void add_checkpoint_results(checkpoint *cp, long long sol_cnt, long long sol_expanded, long long nodes);
+
+void update_checkpoint(checkpoint *cp, bool force);
+
+void free_checkpoint(checkpoint *cp);
+
+#endif
@@ -0,0 +1,55 @@
+/*Here you can find the estimation of the size of the search below a board, which is used to balance the work units before they are solved.
+Following Knuth, a probe walks from the board down to a leaf, branching on the same tiles as the engine but placing only one of the candidate values, which is chosen at random.
+If the tiles along the way had c_1, c_2, ... candidates, the probe estimates c_1 + c_1 c_2 + c_1 c_2 c_3 + ... nodes, which is the true number of nodes on average over all random choices.
+Averaging several probes makes the estimate more reliable, while a probe costs no more than the depth of the search.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "search.h"
+#include "estimate.h"
+
+static inline uint64_t next_random(uint64_t *state){
+    /* This function returns the next number of a xorshift64* generator.
+    */
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545f4914f6cdd1dULL;
+}
+
+double estimate_nodes(const search_state *root, int engine, int probes, uint64_t seed, long long *placed){
+    /* This function estimates the number of tiles the engine places below root as the average of the given number of probes.
+    The choices of the probes only depend on seed, so the same seed gives the same estimate. The tiles placed by the probes are added to placed.
+    */
+    uint64_t state = (seed + 1) * 0x9e3779b97f4a7c15ULL;
+    double total = 0.0;
+    int p, k, cell, pos, skip;
+
+    for (p = 0; p < probes; p++){
+        search_state s = *root;
+        double width = 1.0, nodes = 0.0;
+        pos = 0;
+        while ((cell = next_tile(&s, engine, &pos)) >= 0){
+            valset_t candidates = tile_candidates(&s, cell);
+            if (!candidates)
+                break;
+            // Every candidate value is a node of the level, which is width times as wide as this one on average
+            width *= valset_count(candidates);
+            nodes += width;
+            // Continue with a candidate value chosen at random
+            skip = next_random(&state) % valset_count(candidates);
+            while (skip-- > 0){
+                candidates &= candidates - 1;
+            }
+            k = valset_first(candidates);
+            place_tile(&s, cell, k + s.N_s);
+            (*placed)++;
+        }
+        total += nodes;
+    }
+    return probes > 0 ? total / probes : 0.0;
+}
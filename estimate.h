@@ -0,0 +1,10 @@
+#ifndef ESTIMATE_H
+#define ESTIMATE_H
+
+#include <stdint.h>
+
+#include "search.h"
+
+double estimate_nodes(const search_state *root, int engine, int probes, uint64_t seed, long long *placed);
+
+#endif
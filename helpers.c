@@ -1,4 +1,5 @@
 /*Here you can find some helper functions required for the solver implementation.
+The values which can be placed on a tile are filtered all at once with vector instructions: AVX2 if the CPU supports it, otherwise the portable vector extensions of the compiler, and plain scalar code for the values beyond the last full vector.
 */
 
 #include <stdio.h>
@@ -6,6 +7,8 @@
 #include <stdbool.h>
 #include <time.h>
 
+#include "stats.h"
+
 int find_starting_index(int n, int j){
     /* This function return the first index to access in the current row.
     The general equation holds, that the accessed indexes in the board representation have to add up to (n-1)*3.
@@ -92,6 +95,20 @@ void fill_value_list(int N, bool *array){
     }
 }
 
+void board_values(int r, int n, int (*board)[r][r], int *values){
+    /* This function lists the values of the board in row-major order of the first diagonal, which is the order of the tiles of the flat board representation.
+    */
+    int i, j, row_length, cnt = 0;
+    for (i = 0; i < r; i++){
+        row_length = r-abs(n-1-i);
+        int a[r][3];
+        get_coordinates_of_row(a, 0, i, n);
+        for (j = 0; j < row_length; j++){
+            values[cnt++] = board[a[j][0]][a[j][1]][a[j][2]];
+        }
+    }
+}
+
 void print_board(int r, int n, int (*b)[r][r]){
     /* This function prints out the given board to the console.
     */
@@ -190,6 +207,159 @@ bool validate_tile(int r, int (*board)[r][r], int M, int n, int *tile_placed){
     return true;
 }
 
+// Number of values the vectorized filters test at once
+#define FILTER_LANES 8
+
+// A vector of FILTER_LANES values and one of FILTER_LANES flags in the vector extensions of GCC and Clang
+typedef int filter_vec __attribute__((vector_size(FILTER_LANES * sizeof(int))));
+typedef char filter_flags __attribute__((vector_size(FILTER_LANES)));
+
+static void filter_values_scalar(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable){
+    /* This function marks the unused values from lo to hi as viable, one value at a time.
+    */
+    int k;
+    for (k = 0; k < N; k++){
+        viable[k] = !value_used[k] && k + N_s >= lo && k + N_s <= hi;
+    }
+}
+
+static inline __attribute__((always_inline)) void filter_values_vector(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable){
+    /* This function marks the unused values from lo to hi as viable, FILTER_LANES values at a time.
+    The used flags are loaded, compared and stored as whole vectors, only the values beyond the last full vector are filtered one at a time.
+    */
+    int k;
+    filter_vec lane = {0, 1, 2, 3, 4, 5, 6, 7};
+    // Broadcast the bounds to all lanes
+    filter_vec lo_vec = lane * 0 + lo;
+    filter_vec hi_vec = lane * 0 + hi;
+    filter_vec zero = lane * 0;
+    for (k = 0; k + FILTER_LANES <= N; k += FILTER_LANES){
+        filter_vec values = lane + (k + N_s);
+        filter_flags used_flags, viable_flags;
+        __builtin_memcpy(&used_flags, value_used + k, FILTER_LANES);
+        filter_vec used = __builtin_convertvector(used_flags, filter_vec);
+        // Each lane is -1 if its value is unused and within the bounds and 0 otherwise
+        filter_vec ok = (values >= lo_vec) & (values <= hi_vec) & (used == zero);
+        // A bool is 1 for true, so only the lowest bit of each lane is kept
+        viable_flags = __builtin_convertvector(ok, filter_flags) & 1;
+        __builtin_memcpy(viable + k, &viable_flags, FILTER_LANES);
+    }
+    filter_values_scalar(N - k, N_s + k, lo, hi, value_used + k, viable + k);
+}
+
+static void filter_values_generic(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable){
+    /* This function runs the vectorized filter with the instructions every CPU of the target supports.
+    */
+    filter_values_vector(N, N_s, lo, hi, value_used, viable);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) static void filter_values_avx2(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable){
+    /* This function runs the vectorized filter with AVX2 instructions, which compare all FILTER_LANES values in one register.
+    */
+    filter_values_vector(N, N_s, lo, hi, value_used, viable);
+}
+#endif
+
+// The filter of the candidate values, chosen by select_tile_filter before the search starts
+static void (*tile_filter)(int, int, int, int, const bool *, bool *) = filter_values_generic;
+
+void select_tile_filter(void){
+    /* This function chooses the filter of the candidate values by the features of the CPU we are running on.
+    It has to be called before any thread filters values, as the threads read the choice without synchronization.
+    */
+    tile_filter = filter_values_generic;
+    #if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("avx2"))
+            tile_filter = filter_values_avx2;
+    #endif
+}
+
+void filter_tile_values(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable){
+    /* This function marks the unused values from lo to hi as viable and all others as not.
+    */
+    tile_filter(N, N_s, lo, hi, value_used, viable);
+}
+
+static int sum_of_row(int r, int (*board)[r][r], int n, int diagonal, int row, int *free){
+    /* This function returns the sum of the set tiles of a row and sets free to the number of its empty tiles.
+    */
+    int k, board_val, total = 0;
+    int row_length = r-abs(n-1-row);
+    int coord_arr[row_length][3];
+    get_coordinates_of_row(coord_arr, diagonal, row, n);
+    *free = 0;
+    for (k = 0; k < row_length; k++){
+        board_val = board[coord_arr[k][0]][coord_arr[k][1]][coord_arr[k][2]];
+        if (board_val == 0)
+            (*free)++;
+        else
+            total += board_val;
+    }
+    return total;
+}
+
+#ifdef HEX_STATS
+void count_tile_stats(int r, int (*board)[r][r], int M, int n, int N, int N_s, int *tile, const bool *value_used, const bool *viable){
+    /* This function counts the values tried at an empty tile as nodes and the other values by the reason they are pruned.
+    Without the viable values of a partial check, only used values are pruned. A value the rows rule out is counted as a wrong complete row if the tile is the last empty one of a row it doesn't complete to M, otherwise as out of reach.
+    */
+    int i, k, free, total, placed = 0, tried = 0;
+    // The sum of the rows in which the tile is the last empty one, -1 for the others
+    int last_sum[3];
+
+    for (i = 0; i < 3; i++){
+        total = sum_of_row(r, board, n, i, tile[i], &free);
+        last_sum[i] = free == 1 ? total : -1;
+    }
+
+    for (k = 0; k < N; k++){
+        if (value_used[k]){
+            placed++;
+            thread_stats.prunes[PRUNE_VALUE_USED]++;
+        }
+        else if (viable == NULL || viable[k]){
+            tried++;
+        }
+        else{
+            int reason = PRUNE_SUM_BOUND;
+            for (i = 0; i < 3; i++){
+                if (last_sum[i] >= 0 && last_sum[i] + k + N_s != M)
+                    reason = PRUNE_LINE_WRONG;
+            }
+            thread_stats.prunes[reason]++;
+        }
+    }
+    count_nodes(placed + 1, tried);
+}
+#endif
+
+void viable_tile_values(int r, int (*board)[r][r], int M, int n, int N, int N_s, int *tile, const bool *value_used, bool *viable){
+    /* This function finds all unused values which keep the three rows of an empty tile able to add up to M.
+    If a row has a sum of total and free other empty tiles, these add up to at least the free smallest and at most the free largest values, which bounds the value of the tile from both sides.
+    Every viable value therefore passes validate_tile, and the bounds of the three rows are tested against all values at once.
+    */
+    int i, free, total;
+    int N_e = N_s + N - 1;
+    int lo = N_s, hi = N_e;
+
+    // Loop through each diagonal of the hexagon
+    for (i = 0; i < 3; i++){
+        // Add up the set tiles of the row in which the tile is in in the given diagonal and count the empty ones besides the tile itself
+        total = sum_of_row(r, board, n, i, tile[i], &free);
+        free--;
+
+        // Narrow the bounds by the smallest and largest sum the other empty tiles can add
+        int row_lo = M - total - (free*N_e - free*(free-1)/2);
+        int row_hi = M - total - (free*N_s + free*(free-1)/2);
+        if (row_lo > lo)
+            lo = row_lo;
+        if (row_hi < hi)
+            hi = row_hi;
+    }
+    filter_tile_values(N, N_s, lo, hi, value_used, viable);
+}
+
 double get_time_diff(struct timespec start, struct timespec end){
     /* This function calculates the time difference in seconds between two timespec structs.
     */
@@ -6,10 +6,22 @@ void fill_board(int *values, int r, int n, int (*board)[r][r]);
 
 void fill_value_list(int N, bool *array);
 
+void board_values(int r, int n, int (*board)[r][r], int *values);
+
 void print_board(int r, int n, int (*b)[r][r]);
 
 bool validate_board(int r, int (*board)[r][r], int M, int n);
 
 bool validate_tile(int r, int (*board)[r][r], int M, int n, int *tile_placed);
 
+void select_tile_filter(void);
+
+void filter_tile_values(int N, int N_s, int lo, int hi, const bool *value_used, bool *viable);
+
+#ifdef HEX_STATS
+    void count_tile_stats(int r, int (*board)[r][r], int M, int n, int N, int N_s, int *tile, const bool *value_used, const bool *viable);
+#endif
+
+void viable_tile_values(int r, int (*board)[r][r], int M, int n, int N, int N_s, int *tile, const bool *value_used, bool *viable);
+
 double get_time_diff(struct timespec start, struct timespec end);
\ No newline at end of file
@@ -0,0 +1,192 @@
+/*Here you can find the index of the valid lines, which lists for every line length all sets of distinct values adding up to M.
+The bounds of the search engines only know the smallest and largest sum the empty tiles of a line can add, while the index knows exactly which values can still complete a line.
+For a line with some values placed, every set of the index which contains them and whose other values are unused is a way to complete the line, so the union of their other values are the values its empty tiles can take.
+The sets are also bucketed by the values they contain, so a line only looks at the sets of one of its values.
+The sets of each line length are in the same order as the rows of the row stream, which takes them from the index instead of enumerating them again.
+An index can also be placed in one block of memory, which lets the processes of a node share a single copy of it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "lines.h"
+
+// A growing list of value sets
+typedef struct {
+    valset_t *sets;
+    long long cnt, capacity;
+} set_list;
+
+static bool append_set(set_list *list, valset_t set, long long *total){
+    /* This function appends a set to the list and returns false if the index would get larger than LINE_INDEX_MAX_SETS.
+    */
+    long long cnt;
+    #ifdef _OPENMP
+        #pragma omp atomic capture
+    #endif
+    cnt = ++(*total);
+    if (cnt > LINE_INDEX_MAX_SETS)
+        return false;
+    if (list->cnt == list->capacity){
+        list->capacity = list->capacity > 0 ? 2 * list->capacity : 64;
+        list->sets = realloc(list->sets, list->capacity * sizeof(valset_t));
+        if (list->sets == NULL){
+            printf("Could not allocate memory for %lld value sets!\n", list->capacity);
+            exit(-1);
+        }
+    }
+    list->sets[list->cnt++] = set;
+    return true;
+}
+
+static bool enumerate_sets(int N, int N_s, int M, int left, int next, int sum, valset_t set, set_list *list, long long *total){
+    /* This function appends all sets which extend set by left more value indexes from next on, in ascending order, such that the values add up to M.
+    It returns false once the index got too large.
+    */
+    int i, max_value = N_s + N - 1;
+    if (left == 0)
+        return sum != M || append_set(list, set, total);
+    for (i = next; i <= N - left; i++){
+        int value = i + N_s;
+        // The smallest sum we can still reach is value, value + 1, ..., value + left - 1
+        if (sum + left * value + left * (left - 1) / 2 > M)
+            break;
+        // The largest sum we can still reach is value and the left - 1 largest values
+        if (sum + value + (left - 1) * max_value - (left - 1) * (left - 2) / 2 < M)
+            continue;
+        if (!enumerate_sets(N, N_s, M, left - 1, i + 1, sum + value, set | (valset_t)1 << i, list, total))
+            return false;
+    }
+    return true;
+}
+
+bool build_line_index(line_index *index, int n, int N_s, int M){
+    /* This function builds the index of all value sets adding up to M for the line lengths n to 2n - 1 of a hexagon of side length n.
+    The sets starting with different smallest values are enumerated by different threads and concatenated in order afterwards.
+    It returns false and leaves an empty index if it would hold more than LINE_INDEX_MAX_SETS sets.
+    */
+    int N = 3*n*n - 3*n + 1;
+    int length, first, k;
+    long long i, total = 0;
+    bool ok = true;
+
+    memset(index, 0, sizeof(line_index));
+    index->N_s = N_s;
+    index->M = M;
+    index->N = N;
+    index->min_length = n;
+    index->max_length = 2*n - 1;
+
+    for (length = n; length <= 2*n - 1 && ok; length++){
+        set_list lists[N];
+        memset(lists, 0, sizeof(lists));
+        #ifdef _OPENMP
+            #pragma omp parallel for schedule(dynamic) default(none) shared(N, N_s, M, length, lists, total) reduction(&&:ok)
+        #endif
+        for (first = 0; first < N; first++){
+            ok = ok && enumerate_sets(N, N_s, M, length - 1, first + 1, first + N_s, (valset_t)1 << first, &lists[first], &total);
+        }
+
+        // Concatenate the sets of all smallest values, which keeps them in lexicographic order
+        long long cnt = 0;
+        for (first = 0; first < N; first++){
+            cnt += lists[first].cnt;
+        }
+        index->sets[length] = malloc((cnt > 0 ? cnt : 1) * sizeof(valset_t));
+        index->set_cnt[length] = 0;
+        for (first = 0; first < N; first++){
+            memcpy(index->sets[length] + index->set_cnt[length], lists[first].sets, lists[first].cnt * sizeof(valset_t));
+            index->set_cnt[length] += lists[first].cnt;
+            free(lists[first].sets);
+        }
+
+        // Put every set into the buckets of its values
+        for (i = 0; i < cnt; i++){
+            valset_t rest = index->sets[length][i];
+            while (rest){
+                index->bucket_cnt[length][valset_first(rest)]++;
+                rest &= rest - 1;
+            }
+        }
+        for (k = 0; k < N; k++){
+            index->buckets[length][k] = malloc((index->bucket_cnt[length][k] > 0 ? index->bucket_cnt[length][k] : 1) * sizeof(valset_t));
+            index->bucket_cnt[length][k] = 0;
+        }
+        for (i = 0; i < cnt; i++){
+            valset_t rest = index->sets[length][i];
+            while (rest){
+                k = valset_first(rest);
+                rest &= rest - 1;
+                index->buckets[length][k][index->bucket_cnt[length][k]++] = index->sets[length][i];
+            }
+        }
+    }
+
+    if (!ok){
+        free_line_index(index);
+        return false;
+    }
+    return true;
+}
+
+void free_line_index(line_index *index){
+    /* This function releases the memory of the index and leaves it empty.
+    An index placed in memory it doesn't own only forgets it.
+    */
+    int length, k;
+    for (length = 0; length <= HEX_MAX_ROWS && !index->placed; length++){
+        free(index->sets[length]);
+        for (k = 0; k < VALSET_BITS; k++){
+            free(index->buckets[length][k]);
+        }
+    }
+    memset(index, 0, sizeof(line_index));
+}
+
+size_t line_index_bytes(const line_index *index){
+    /* This function returns the size of one block of memory holding all sets and buckets of the index, which only depends on their counts.
+    */
+    int length, k;
+    long long cnt = 0;
+    for (length = index->min_length; length <= index->max_length; length++){
+        cnt += index->set_cnt[length];
+        for (k = 0; k < index->N; k++){
+            cnt += index->bucket_cnt[length][k];
+        }
+    }
+    return (size_t)cnt * sizeof(valset_t);
+}
+
+void place_line_index(line_index *index, void *memory){
+    /* This function points the sets and buckets of the index at consecutive parts of memory, which has to hold line_index_bytes.
+    Only the counts of the index are used, so every process which knows them places the index the same way, whatever address the memory has in it.
+    */
+    valset_t *next = memory;
+    int length, k;
+    for (length = index->min_length; length <= index->max_length; length++){
+        index->sets[length] = next;
+        next += index->set_cnt[length];
+        for (k = 0; k < index->N; k++){
+            index->buckets[length][k] = next;
+            next += index->bucket_cnt[length][k];
+        }
+    }
+    index->placed = true;
+}
+
+void copy_line_index(line_index *dst, const line_index *src){
+    /* This function copies the sets and buckets of src into the index dst, which has the same counts and is already placed.
+    */
+    int length, k;
+    for (length = src->min_length; length <= src->max_length; length++){
+        memcpy(dst->sets[length], src->sets[length], src->set_cnt[length] * sizeof(valset_t));
+        for (k = 0; k < src->N; k++){
+            memcpy(dst->buckets[length][k], src->buckets[length][k], src->bucket_cnt[length][k] * sizeof(valset_t));
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef LINES_H
+#define LINES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "board.h"
+#include "valset.h"
+
+// Largest number of value sets the index holds over all line lengths, larger indexes are not built
+#define LINE_INDEX_MAX_SETS (1 << 24)
+// Largest number of sets a line looks at, lines with larger buckets are only restricted by the bounds of their sums
+#ifndef LINE_INDEX_MAX_BUCKET
+    #define LINE_INDEX_MAX_BUCKET 1024
+#endif
+
+// The index of all sets of distinct values which add up to M, for every line length of a hexagon.
+// It is built once per n, N_s and M and only read afterwards, so all threads share it.
+typedef struct {
+    int N_s, M, N;
+    int min_length, max_length;
+    // The value sets of each line length as bitmasks, in lexicographic order of their sorted values
+    valset_t *sets[HEX_MAX_ROWS + 1];
+    long long set_cnt[HEX_MAX_ROWS + 1];
+    // For each line length and value index, the sets which contain the value
+    valset_t *buckets[HEX_MAX_ROWS + 1][VALSET_BITS];
+    int bucket_cnt[HEX_MAX_ROWS + 1][VALSET_BITS];
+    // Whether the sets and buckets lie in one block of memory the index doesn't own, like a window shared by the processes of a node
+    bool placed;
+} line_index;
+
+bool build_line_index(line_index *index, int n, int N_s, int M);
+
+void free_line_index(line_index *index);
+
+size_t line_index_bytes(const line_index *index);
+
+void place_line_index(line_index *index, void *memory);
+
+void copy_line_index(line_index *dst, const line_index *src);
+
+static inline valset_t line_index_values(const line_index *index, int length, valset_t placed, valset_t available){
+    /* This function returns the values the empty tiles of a line of the given length can still take if the values placed are already set on it and only the available ones are left.
+    These are the remaining values of all sets which contain the placed values and are otherwise available. At least one value has to be placed, its bucket holds the sets to check.
+    If even the smallest bucket of the placed values is larger than LINE_INDEX_MAX_BUCKET, checking it would cost more than it saves and all available values are returned.
+    */
+    const valset_t *bucket = NULL;
+    int cnt = 0, k, i;
+    valset_t rest = placed, allowed = 0;
+    // Check the sets of the placed value which is contained in the fewest sets
+    while (rest){
+        k = valset_first(rest);
+        rest &= rest - 1;
+        if (bucket == NULL || index->bucket_cnt[length][k] < cnt){
+            bucket = index->buckets[length][k];
+            cnt = index->bucket_cnt[length][k];
+        }
+    }
+    if (cnt > LINE_INDEX_MAX_BUCKET)
+        return available;
+    for (i = 0; i < cnt; i++){
+        valset_t set = bucket[i];
+        if ((set & placed) == placed && (set & ~placed & ~available) == 0)
+            allowed |= set;
+    }
+    return allowed & ~placed;
+}
+
+#endif
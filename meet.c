@@ -0,0 +1,535 @@
+/*Here you can find the meet-in-the-middle solver, which splits the board at the middle row of the first diagonal instead of searching all tiles at once.
+The rows above the middle row (the upper half) and the rows below it (the lower half) are enumerated separately, each with the same candidate values as the search engines on its own tiles.
+Every row of a half is a complete line which has to add up to M, so only few assignments of a half remain.
+
+Every line of the other two diagonals crosses the middle row in exactly one tile. Once both halves are set, the value of that tile is M minus the sums of both halves on the line, and the two lines through it have to agree on the value.
+So an upper and a lower half fit together if, for every tile of the middle row, the difference of the sums of the upper half on its two lines is the negated difference of the lower half. These differences are the key of a half.
+The lower halves are stored in a hash table by their key and every upper half looks up its own, which costs the number of upper and lower halves instead of their product.
+For a pair with the same key and disjoint values the middle row is derived, and the complete board is checked on a search state.
+
+If the lower halves and their table take more memory than allowed, the halves of both sides are written to disk instead, split by their key into partitions.
+Matching halves end up in the same partition, so the partitions are joined one after another and only one partition of lower halves has to fit into memory at once.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "board.h"
+#include "search.h"
+#include "meet.h"
+#include "stats.h"
+#include "sink.h"
+
+// The tiles of both halves and the layout of their records.
+// A record holds the used values, the key and the sums on the first crossing line of every tile of the middle row, and the value indexes of the tiles of the half.
+typedef struct {
+    const search_state *root;
+    const meet_options *opt;
+    int r, N, N_s, M;
+    // The upper half are the tiles before upper_end, the middle row the tiles up to middle_end and the lower half the rest
+    int upper_end, middle_end, half_size;
+    // The lines of the second and third diagonal through every tile of the middle row
+    int cross[HEX_MAX_ROWS][2];
+    size_t record_size, sums_offset, cells_offset;
+} meet_plan;
+
+// A growing list of records of equal size
+typedef struct {
+    unsigned char *data;
+    size_t cnt, capacity, record_size;
+} record_list;
+
+// The halves of one side, which are kept in memory until they take more than cap bytes and written to the file of their partition afterwards
+typedef struct {
+    record_list memory;
+    FILE *files[MEET_PARTITIONS];
+    bool spilled;
+    size_t cap;
+    const char *dir;
+    long long cnt;
+} record_store;
+
+// A hash table of the indexes of the records of a list, -1 marks an empty slot
+typedef struct {
+    const record_list *records;
+    long long *slots;
+    size_t mask;
+} meet_table;
+
+// A thread enumerating the tiles of a half up to end and handing every complete half either to a store or to the table to join it right away
+typedef struct {
+    const meet_plan *plan;
+    bool upper;
+    int end;
+    record_store *store;
+    const meet_table *table;
+    record_list batch;
+    unsigned char *record;
+    long long halves;
+    task_results res;
+} half_walker;
+
+static void init_plan(meet_plan *plan, const search_state *root, const meet_options *opt){
+    /* This function finds the tiles of both halves and the middle row and the lines crossing the middle row.
+    */
+    const board_layout *layout = root->layout;
+    int i, cell;
+    plan->root = root;
+    plan->opt = opt;
+    plan->r = layout->r;
+    plan->N = layout->N;
+    plan->N_s = root->N_s;
+    plan->M = root->M;
+    plan->upper_end = layout->row_start[layout->n - 1];
+    plan->middle_end = plan->upper_end + layout->r;
+    plan->half_size = plan->upper_end;
+    for (i = 0; i < plan->r; i++){
+        cell = plan->upper_end + i;
+        plan->cross[i][0] = layout->cell_lines[cell][1];
+        plan->cross[i][1] = layout->cell_lines[cell][2];
+    }
+    plan->sums_offset = sizeof(valset_t) + plan->r * sizeof(short);
+    plan->cells_offset = plan->sums_offset + plan->r * sizeof(short);
+    // Keep the used values of every record aligned
+    plan->record_size = (plan->cells_offset + plan->half_size + sizeof(valset_t) - 1) / sizeof(valset_t) * sizeof(valset_t);
+}
+
+static inline valset_t record_used(const unsigned char *record){
+    return *(const valset_t *)record;
+}
+
+static inline const short *record_key(const unsigned char *record){
+    return (const short *)(record + sizeof(valset_t));
+}
+
+static inline uint64_t key_hash(const meet_plan *plan, const unsigned char *record){
+    /* This function returns the FNV-1a hash of the key of a record.
+    */
+    const short *key = record_key(record);
+    uint64_t hash = 14695981039346656037ULL;
+    int i;
+    for (i = 0; i < plan->r; i++){
+        hash ^= (uint16_t)key[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ^ (hash >> 32);
+}
+
+static void make_record(const meet_plan *plan, const search_state *s, bool upper, unsigned char *record){
+    /* This function writes the record of the half which is set on the search state.
+    */
+    short *key = (short *)(record + sizeof(valset_t));
+    short *sums = (short *)(record + plan->sums_offset);
+    unsigned char *cells = record + plan->cells_offset;
+    int first = upper ? 0 : plan->middle_end;
+    int i, a, b;
+    memset(record, 0, plan->record_size);
+    *(valset_t *)record = ~s->available & valset_range(0, plan->N - 1);
+    for (i = 0; i < plan->r; i++){
+        a = s->line_sum[plan->cross[i][0]];
+        b = s->line_sum[plan->cross[i][1]];
+        key[i] = upper ? a - b : b - a;
+        sums[i] = a;
+    }
+    for (i = 0; i < plan->half_size; i++){
+        cells[i] = s->cells[first + i] - plan->N_s;
+    }
+}
+
+static void reserve_records(record_list *list, size_t cnt){
+    /* This function makes sure the list can hold cnt records, doubling its capacity until it does.
+    */
+    if (cnt <= list->capacity)
+        return;
+    size_t capacity = list->capacity > 0 ? list->capacity : 64;
+    while (capacity < cnt){
+        capacity *= 2;
+    }
+    list->data = realloc(list->data, capacity * list->record_size);
+    if (list->data == NULL){
+        printf("Could not allocate memory for %zu halves!\n", capacity);
+        exit(-1);
+    }
+    list->capacity = capacity;
+}
+
+static void append_record(record_list *list, const unsigned char *record){
+    reserve_records(list, list->cnt + 1);
+    memcpy(list->data + list->cnt * list->record_size, record, list->record_size);
+    list->cnt++;
+}
+
+static void free_records(record_list *list){
+    free(list->data);
+    list->data = NULL;
+    list->cnt = 0;
+    list->capacity = 0;
+}
+
+static FILE *open_spill_file(const char *dir){
+    /* This function opens an anonymous file in dir, which is removed once it is closed.
+    */
+    FILE *file = NULL;
+    if (dir == NULL)
+        file = tmpfile();
+    else{
+        char path[strlen(dir) + 32];
+        snprintf(path, sizeof(path), "%s/hexagon-meet-XXXXXX", dir);
+        int fd = mkstemp(path);
+        if (fd >= 0){
+            file = fdopen(fd, "w+b");
+            unlink(path);
+        }
+    }
+    if (file == NULL){
+        printf("Could not open a file in %s to write the halves to!\n", dir != NULL ? dir : "the temporary directory");
+        exit(-1);
+    }
+    return file;
+}
+
+static void init_store(record_store *store, size_t record_size, size_t cap, const char *dir){
+    memset(store, 0, sizeof(record_store));
+    store->memory.record_size = record_size;
+    store->cap = cap;
+    store->dir = dir;
+}
+
+static void write_record(const meet_plan *plan, record_store *store, const unsigned char *record){
+    /* This function appends a record to the file of the partition of its key.
+    */
+    FILE *file = store->files[key_hash(plan, record) % MEET_PARTITIONS];
+    if (fwrite(record, plan->record_size, 1, file) != 1){
+        printf("Could not write the halves to disk!\n");
+        exit(-1);
+    }
+}
+
+static void spill_store(const meet_plan *plan, record_store *store){
+    /* This function writes the records held in memory to the files of their partitions, to which all further records go as well.
+    */
+    size_t i;
+    int p;
+    for (p = 0; p < MEET_PARTITIONS; p++){
+        store->files[p] = open_spill_file(store->dir);
+    }
+    for (i = 0; i < store->memory.cnt; i++){
+        write_record(plan, store, store->memory.data + i * plan->record_size);
+    }
+    free_records(&store->memory);
+    store->spilled = true;
+}
+
+static void add_records(const meet_plan *plan, record_store *store, record_list *batch){
+    /* This function moves the records of a batch to the store.
+    The records and about two slots of the hash table per record have to fit into the memory cap, otherwise the store is written to disk.
+    */
+    size_t i;
+    #ifdef _OPENMP
+        #pragma omp critical(meet_store)
+    #endif
+    {
+        if (!store->spilled && (store->memory.cnt + batch->cnt) * (plan->record_size + 2 * sizeof(long long)) > store->cap)
+            spill_store(plan, store);
+        for (i = 0; i < batch->cnt; i++){
+            if (store->spilled)
+                write_record(plan, store, batch->data + i * plan->record_size);
+            else
+                append_record(&store->memory, batch->data + i * plan->record_size);
+        }
+        store->cnt += batch->cnt;
+    }
+    batch->cnt = 0;
+}
+
+static void read_partition(const meet_plan *plan, record_store *store, int p, record_list *list){
+    /* This function reads all records of a partition written to disk into the list.
+    */
+    FILE *file = store->files[p];
+    fseek(file, 0, SEEK_END);
+    size_t cnt = ftell(file) / plan->record_size;
+    rewind(file);
+    reserve_records(list, cnt);
+    if (fread(list->data, plan->record_size, cnt, file) != cnt){
+        printf("Could not read the halves from disk!\n");
+        exit(-1);
+    }
+    list->cnt = cnt;
+}
+
+static void free_store(record_store *store){
+    int p;
+    free_records(&store->memory);
+    if (store->spilled){
+        for (p = 0; p < MEET_PARTITIONS; p++){
+            fclose(store->files[p]);
+        }
+    }
+    store->spilled = false;
+}
+
+static void build_table(const meet_plan *plan, meet_table *table, const record_list *records){
+    /* This function inserts the indexes of all records into a hash table with at least twice as many slots.
+    The slot of a record is taken from the bits of its hash above the ones selecting its partition, which are the same for all records of a partition.
+    */
+    size_t size = 2, i, slot;
+    while (size < 2 * records->cnt){
+        size *= 2;
+    }
+    table->records = records;
+    table->mask = size - 1;
+    table->slots = malloc(size * sizeof(long long));
+    if (table->slots == NULL){
+        printf("Could not allocate memory for the hash table of %zu halves!\n", records->cnt);
+        exit(-1);
+    }
+    memset(table->slots, -1, size * sizeof(long long));
+    for (i = 0; i < records->cnt; i++){
+        slot = (key_hash(plan, records->data + i * plan->record_size) / MEET_PARTITIONS) & table->mask;
+        while (table->slots[slot] >= 0){
+            slot = (slot + 1) & table->mask;
+        }
+        table->slots[slot] = i;
+    }
+}
+
+static void join_halves(const meet_plan *plan, const unsigned char *upper, const unsigned char *lower, task_results *res){
+    /* This function derives the middle row of an upper and a lower half with the same key and checks the complete board.
+    A valid board is counted and printed like the search engines do, or stored in res if we only want to find the first solution.
+    */
+    valset_t used = record_used(upper), middle = 0, bit;
+    int values[HEX_MAX_ROWS];
+    int i, value;
+    if (used & record_used(lower))
+        return;
+    used |= record_used(lower);
+    const short *upper_sums = (const short *)(upper + plan->sums_offset);
+    const short *lower_sums = (const short *)(lower + plan->sums_offset);
+    // The first crossing line of every tile of the middle row determines its value, which has to be unused
+    for (i = 0; i < plan->r; i++){
+        value = plan->M - upper_sums[i] - lower_sums[i];
+        if (value < plan->N_s || value >= plan->N_s + plan->N)
+            return;
+        bit = (valset_t)1 << (value - plan->N_s);
+        if ((used | middle) & bit)
+            return;
+        middle |= bit;
+        values[i] = value;
+    }
+
+    // Check all lines of the complete board, including the middle row, and the order of its corners
+    search_state s = *plan->root;
+    for (i = 0; i < plan->half_size; i++){
+        place_tile(&s, i, upper[plan->cells_offset + i] + plan->N_s);
+        place_tile(&s, plan->middle_end + i, lower[plan->cells_offset + i] + plan->N_s);
+    }
+    for (i = 0; i < plan->r; i++){
+        place_tile(&s, plan->upper_end + i, values[i]);
+    }
+    #ifdef HEX_STATS
+        thread_stats.leaves++;
+    #endif
+    if (s.lines_wrong > 0 || !validate_symmetry(&s))
+        return;
+    if (s.find_all){
+        if (s.print_solutions)
+            sink_solution(s.cells, plan->N);
+        res->sol_cnt++;
+        res->sol_expanded += s.symmetry ? count_symmetric_boards(s.layout, s.cells) : 1;
+    }
+    else if (!res->found){
+        memcpy(res->cells, s.cells, plan->N * sizeof(int));
+        res->found = true;
+        set_search_stop(true);
+    }
+}
+
+static void probe_table(const meet_plan *plan, const meet_table *table, const unsigned char *upper, task_results *res){
+    /* This function joins an upper half with all lower halves of the table which have the same key.
+    */
+    size_t slot = (key_hash(plan, upper) / MEET_PARTITIONS) & table->mask;
+    const unsigned char *lower;
+    while (table->slots[slot] >= 0){
+        lower = table->records->data + table->slots[slot] * plan->record_size;
+        if (memcmp(record_key(lower), record_key(upper), plan->r * sizeof(short)) == 0)
+            join_halves(plan, upper, lower, res);
+        slot = (slot + 1) & table->mask;
+    }
+}
+
+static void merge_results(task_results *res, const task_results *local){
+    /* This function adds the results of a thread to the shared results.
+    */
+    #ifdef _OPENMP
+        #pragma omp critical(meet_results)
+    #endif
+    {
+        res->sol_cnt += local->sol_cnt;
+        res->sol_expanded += local->sol_expanded;
+        res->nodes += local->nodes;
+        if (local->found && !res->found){
+            memcpy(res->cells, local->cells, sizeof(local->cells));
+            res->found = true;
+        }
+    }
+}
+
+static void visit_half(half_walker *w, const search_state *s){
+    /* This function hands a complete half to the store or joins it with the table right away.
+    */
+    w->halves++;
+    make_record(w->plan, s, w->upper, w->record);
+    if (w->table != NULL){
+        probe_table(w->plan, w->table, w->record, &w->res);
+        return;
+    }
+    append_record(&w->batch, w->record);
+    if (w->batch.cnt >= MEET_BATCH)
+        add_records(w->plan, w->store, &w->batch);
+}
+
+static void walk_half(half_walker *w, search_state *s, int cell){
+    /* This function tries all candidate values on the tiles of the half from cell on and visits every complete half whose lines are not wrong.
+    */
+    int k;
+    if (search_stopped())
+        return;
+    if (cell == w->end){
+        if (s->lines_wrong == 0)
+            visit_half(w, s);
+        return;
+    }
+    valset_t candidates = tile_candidates(s, cell);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        place_tile(s, cell, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+        walk_half(w, s, cell + 1);
+        remove_tile(s, cell);
+    }
+}
+
+static long long enumerate_half(const meet_plan *plan, bool upper, record_store *store, const meet_table *table, task_results *res){
+    /* This function enumerates the upper or the lower half, split among the threads by the value of its first tile, and returns the number of halves.
+    Of the upper half, only the values of the first tile in the share of this process are enumerated. Every process enumerates the whole lower half, but only the one with offset 0 counts its nodes, so the total doesn't grow with the number of processes.
+    */
+    int first = upper ? 0 : plan->middle_end;
+    int end = upper ? plan->upper_end : plan->N;
+    int stride = upper ? plan->opt->stride : 1;
+    int offset = upper ? plan->opt->offset : 0;
+    long long halves = 0;
+    int k;
+    // A hexagon of side length 1 has empty halves, which are enumerated once
+    bool empty = first == end;
+    valset_t candidates = empty ? 1 : tile_candidates(plan->root, first);
+
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) default(none) shared(plan, upper, store, table, res, first, end, stride, offset, empty, candidates) reduction(+:halves)
+    #endif
+    for (k = 0; k < plan->N; k++){
+        if (!((candidates >> k) & 1) || k % stride != offset || search_stopped())
+            continue;
+        half_walker w = {.plan = plan, .upper = upper, .end = end, .store = store, .table = table, .halves = 0};
+        unsigned char record[plan->record_size];
+        w.record = record;
+        memset(&w.batch, 0, sizeof(record_list));
+        w.batch.record_size = plan->record_size;
+        memset(&w.res, 0, sizeof(task_results));
+
+        search_state s = *plan->root;
+        if (!empty){
+            place_tile(&s, first, k + s.N_s);
+            s.nodes++;
+        }
+        walk_half(&w, &s, empty ? first : first + 1);
+        if (w.batch.cnt > 0)
+            add_records(plan, store, &w.batch);
+        free_records(&w.batch);
+        w.res.nodes = upper || plan->opt->offset == 0 ? s.nodes - plan->root->nodes : 0;
+        merge_results(res, &w.res);
+        halves += w.halves;
+    }
+    return halves;
+}
+
+static void join_partitions(const meet_plan *plan, record_store *lower, record_store *upper, task_results *res){
+    /* This function joins the halves written to disk one partition after another.
+    The lower halves of a partition are read into a hash table, and the upper halves are read in batches which the threads look up in parallel.
+    */
+    record_list lower_records = {NULL, 0, 0, plan->record_size};
+    record_list batch = {NULL, 0, 0, plan->record_size};
+    meet_table table;
+    long long i;
+    int p;
+    for (p = 0; p < MEET_PARTITIONS && !search_stopped(); p++){
+        read_partition(plan, lower, p, &lower_records);
+        build_table(plan, &table, &lower_records);
+        rewind(upper->files[p]);
+        reserve_records(&batch, MEET_BATCH);
+        while ((batch.cnt = fread(batch.data, plan->record_size, MEET_BATCH, upper->files[p])) > 0){
+            #ifdef _OPENMP
+                #pragma omp parallel default(none) private(i) shared(plan, table, batch, res)
+            #endif
+            {
+                task_results local;
+                memset(&local, 0, sizeof(task_results));
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static)
+                #endif
+                for (i = 0; i < (long long)batch.cnt; i++){
+                    if (!search_stopped())
+                        probe_table(plan, &table, batch.data + i * plan->record_size, &local);
+                }
+                merge_results(res, &local);
+            }
+            if (search_stopped())
+                break;
+        }
+        free(table.slots);
+        lower_records.cnt = 0;
+    }
+    free_records(&lower_records);
+    free_records(&batch);
+}
+
+void search_meet(const search_state *root, const meet_options *opt, task_results *res){
+    /* This function searches the boards below the empty board root by joining its upper and lower halves, and adds the results to res.
+    The lower halves are enumerated first. If they fit into memory, every upper half is joined with them as soon as it is set, otherwise both sides are joined partition by partition on disk.
+    On disk, no board is complete before the partitions are joined. So even when only the first solution is searched, all upper halves of this process are written first, unless another process finds a solution and stops the enumeration.
+    */
+    meet_plan plan;
+    init_plan(&plan, root, opt);
+    record_store lower, upper;
+    init_store(&lower, plan.record_size, opt->memory_cap, opt->spill_dir);
+    long long lower_cnt = enumerate_half(&plan, false, &lower, NULL, res);
+    long long upper_cnt;
+
+    if (!lower.spilled){
+        meet_table table;
+        build_table(&plan, &table, &lower.memory);
+        upper_cnt = enumerate_half(&plan, true, NULL, &table, res);
+        free(table.slots);
+        if (opt->report)
+            printf("Joined %lld upper halves with %lld lower halves in memory.\n", upper_cnt, lower_cnt);
+    }
+    else{
+        // The upper halves go to disk right away
+        init_store(&upper, plan.record_size, 0, opt->spill_dir);
+        spill_store(&plan, &upper);
+        upper_cnt = enumerate_half(&plan, true, &upper, NULL, res);
+        join_partitions(&plan, &lower, &upper, res);
+        free_store(&upper);
+        if (opt->report)
+            printf("Joined %lld upper halves with %lld lower halves in %d partitions on disk, as they take more than %zu bytes.\n", upper_cnt, lower_cnt, MEET_PARTITIONS, opt->memory_cap);
+    }
+    free_store(&lower);
+}
@@ -0,0 +1,28 @@
+#ifndef MEET_H
+#define MEET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "search.h"
+
+// Number of partitions the halves are split into once the lower halves don't fit into memory
+#define MEET_PARTITIONS 64
+// Number of halves a thread collects before it adds them to the shared records
+#define MEET_BATCH 4096
+
+// The options of the meet-in-the-middle solver
+typedef struct {
+    // Bytes the lower halves and their hash table may take in memory before all halves are written to disk
+    size_t memory_cap;
+    // The directory of the files the halves are written to, NULL for the temporary directory of the system
+    const char *spill_dir;
+    // The upper halves are split round robin into stride shares by the value of their first tile, of which this process joins share offset
+    int stride, offset;
+    // Whether to print how the halves were joined
+    bool report;
+} meet_options;
+
+void search_meet(const search_state *root, const meet_options *opt, task_results *res);
+
+#endif
@@ -0,0 +1,87 @@
+/*Here you can find the table of the remaining boards the search engines already searched, which lets them skip boards they reach again.
+Different work units often reach the same remaining board: the same empty tiles, the same unused values and the same sums on every line. Which values are on which set tile doesn't matter for the tiles still to fill, so such boards have the same solutions.
+A board is identified by a 64 bit key, the XOR of a random key for each empty tile, each used value and the sum of each line, which the search state updates on every placement.
+The table stores how many solutions were found below a board, so a dead end is found again without searching it. Boards with solutions are only reused if the solutions don't have to be printed.
+Every thread has its own table of fixed size, so looking up and storing never synchronizes. Collisions of the 64 bit keys are not checked for.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "memo.h"
+
+int memo_bits = 0;
+
+// Every thread looks up boards in its own table, which is allocated on the first look up
+static search_memo thread_memo;
+#ifdef _OPENMP
+    #pragma omp threadprivate(thread_memo)
+#endif
+
+static search_memo *get_thread_memo(void){
+    /* This function returns the table of the calling thread and allocates it if it doesn't have one yet.
+    */
+    if (thread_memo.entries == NULL){
+        thread_memo.entries = calloc((size_t)1 << memo_bits, sizeof(memo_entry));
+        if (thread_memo.entries == NULL){
+            printf("Could not allocate memory for %lld boards to look up!\n", 1LL << memo_bits);
+            exit(-1);
+        }
+        thread_memo.mask = ((uint64_t)1 << memo_bits) - 1;
+    }
+    return &thread_memo;
+}
+
+bool memo_lookup(uint64_t key, bool counts, long long *sol_cnt){
+    /* This function returns whether the board with the given key is in the table of the thread and sets its number of solutions.
+    If counts is not set, only dead ends are returned.
+    */
+    search_memo *memo = get_thread_memo();
+    const memo_entry *entry = &memo->entries[key & memo->mask];
+    if (entry->key == key && (counts || entry->sol_cnt == 0)){
+        *sol_cnt = entry->sol_cnt;
+        memo->hits++;
+        return true;
+    }
+    memo->misses++;
+    return false;
+}
+
+void memo_store(uint64_t key, long long sol_cnt){
+    /* This function stores the number of solutions of the board with the given key in the table of the thread.
+    */
+    search_memo *memo = get_thread_memo();
+    memo_entry *entry = &memo->entries[key & memo->mask];
+    entry->key = key;
+    entry->sol_cnt = sol_cnt;
+}
+
+void collect_memo_stats(long long *hits, long long *misses){
+    /* This function adds the hits and misses of the tables of all threads and releases the tables.
+    Like the statistics of the search, the tables of the threads of the default team are visited by a parallel region with the same number of threads.
+    */
+    #ifdef _OPENMP
+        #pragma omp parallel
+    #endif
+    {
+        #ifdef _OPENMP
+            #pragma omp critical(memo_stats)
+        #endif
+        {
+            *hits += thread_memo.hits;
+            *misses += thread_memo.misses;
+        }
+        free(thread_memo.entries);
+        memset(&thread_memo, 0, sizeof(search_memo));
+    }
+}
+
+void print_memo_stats(long long hits, long long misses){
+    /* This function prints how often the remaining boards were found in the tables, which helps to choose their size.
+    */
+    long long lookups = hits + misses;
+    printf("The remaining boards were looked up %lld times in tables of %lld boards per thread, %lld hits (%lf%%) and %lld misses.\n", lookups, 1LL << memo_bits, hits, lookups > 0 ? 100.0 * hits / lookups : 0.0, misses);
+}
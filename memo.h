@@ -0,0 +1,58 @@
+#ifndef MEMO_H
+#define MEMO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Number of empty tiles a board needs to be looked up, smaller subtrees are searched faster than they are looked up
+#ifndef MEMO_MIN_EMPTY
+    #define MEMO_MIN_EMPTY 4
+#endif
+
+// The key of a remaining board and the number of solutions below it, which is 0 for a dead end. A key of 0 marks an empty entry.
+typedef struct {
+    uint64_t key;
+    long long sol_cnt;
+} memo_entry;
+
+// The table of a thread, which holds 2^memo_bits entries. A board can only be stored in the entry selected by its key and replaces the board stored there.
+typedef struct {
+    memo_entry *entries;
+    uint64_t mask;
+    long long hits, misses;
+} search_memo;
+
+// Number of entries of the table of every thread as a power of two, 0 if no boards are looked up
+extern int memo_bits;
+
+static inline uint64_t memo_mix(uint64_t x){
+    /* This function returns a well mixed 64 bit key of x, using the finalizer of splitmix64.
+    */
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// The parts of the key of a board, which is the XOR of the parts of its empty tiles, its used values and the sum of each line
+static inline uint64_t memo_cell_key(int cell){
+    return memo_mix((uint64_t)1 << 48 | (uint64_t)cell);
+}
+
+static inline uint64_t memo_value_key(int k){
+    return memo_mix((uint64_t)2 << 48 | (uint64_t)k);
+}
+
+static inline uint64_t memo_line_key(int line, int sum){
+    return memo_mix((uint64_t)(3 + line) << 48 | (uint32_t)sum);
+}
+
+bool memo_lookup(uint64_t key, bool counts, long long *sol_cnt);
+
+void memo_store(uint64_t key, long long sol_cnt);
+
+void collect_memo_stats(long long *hits, long long *misses);
+
+void print_memo_stats(long long hits, long long misses);
+
+#endif
@@ -0,0 +1,288 @@
+/*Here you can find the streams of work units, which are handed to the solver in batches instead of being computed all at once.
+Instead of enumerating all ordered tuples of values and checking their sum at the end, the values of a row are first chosen as a sorted combination.
+A partial combination is discarded as soon as the remaining positions can't reach M anymore, and every complete combination is then expanded into all of its permutations.
+The combinations are enumerated one at a time, so a stream only holds the current combination and the batch it is filling, no matter how many rows there are in total.
+Alternatively, the work units can be the frontier of the search itself: the partial boards the search engine reaches after a number of placements, which already satisfy all partial checks.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "prefix.h"
+#include "search.h"
+
+void init_row_buffer(row_buffer *buffer, int row_length){
+    /* This function initializes an empty list of rows.
+    */
+    buffer->values = NULL;
+    buffer->cnt = 0;
+    buffer->capacity = 0;
+    buffer->row_length = row_length;
+}
+
+void reserve_rows(row_buffer *buffer, int cnt){
+    /* This function makes sure the list can hold cnt rows, doubling its capacity until it does.
+    */
+    if (cnt <= buffer->capacity)
+        return;
+    int capacity = buffer->capacity > 0 ? buffer->capacity : 64;
+    while (capacity < cnt){
+        capacity *= 2;
+    }
+    buffer->values = realloc(buffer->values, (size_t)capacity * buffer->row_length * sizeof(int));
+    if (buffer->values == NULL){
+        printf("Could not allocate memory for %d rows!\n", capacity);
+        exit(-1);
+    }
+    buffer->capacity = capacity;
+}
+
+void append_row(row_buffer *buffer, const int *row){
+    /* This function appends a row to the list and grows it if it is full.
+    */
+    reserve_rows(buffer, buffer->cnt + 1);
+    memcpy(buffer->values + (size_t)buffer->cnt * buffer->row_length, row, buffer->row_length * sizeof(int));
+    buffer->cnt++;
+}
+
+void free_row_buffer(row_buffer *buffer){
+    /* This function releases the memory of a list of rows.
+    */
+    free(buffer->values);
+    init_row_buffer(buffer, buffer->row_length);
+}
+
+static bool next_permutation(int *a, int length){
+    /* This function rearranges the values into the lexicographically next permutation and returns false if they were in descending order.
+    */
+    int i = length - 2, j, t;
+    while (i >= 0 && a[i] >= a[i+1]){
+        i--;
+    }
+    if (i < 0)
+        return false;
+    j = length - 1;
+    while (a[j] <= a[i]){
+        j--;
+    }
+    t = a[i];
+    a[i] = a[j];
+    a[j] = t;
+    // Reverse the descending tail
+    for (i = i + 1, j = length - 1; i < j; i++, j--){
+        t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+    return true;
+}
+
+static bool next_combination(unit_stream *stream){
+    /* This function advances the stream to the next sorted combination of distinct values which add up to M and returns false if there is none left.
+    Position depth is increased until either its value is too large for the remaining positions to stay below M, which backtracks, or the largest values left can reach M, which fixes it and continues with the next position.
+    */
+    int L = stream->row_length, M = stream->M;
+    int max_value = stream->N - 1 + stream->N_s;
+    int *c = stream->combination;
+    int depth = stream->depth;
+    int i, left, sum;
+
+    // The index lists the combinations in the same order, so the next one is read from it
+    if (stream->sets != NULL){
+        if (stream->combinations >= stream->set_cnt)
+            return false;
+        valset_t set = stream->sets[stream->combinations];
+        for (i = 0; i < L; i++){
+            c[i] = valset_first(set) + stream->N_s;
+            set &= set - 1;
+        }
+        return true;
+    }
+
+    while (depth >= 0){
+        i = ++c[depth];
+        left = L - depth;
+        sum = stream->sums[depth];
+        // The smallest sum we can still reach is i, i+1, ..., i+left-1
+        if (i > max_value - left + 1 || sum + left * i + left * (left - 1) / 2 > M){
+            depth--;
+            continue;
+        }
+        // The largest sum we can still reach is i and the left-1 largest values
+        if (sum + i + (left - 1) * max_value - (left - 1) * (left - 2) / 2 < M)
+            continue;
+        if (depth == L - 1){
+            // Both bounds are the sum of the complete combination, so it adds up to M
+            stream->depth = depth;
+            return true;
+        }
+        // Fix the position, the next one starts above its value
+        stream->sums[depth + 1] = sum + i;
+        depth++;
+        c[depth] = i;
+    }
+    stream->depth = depth;
+    return false;
+}
+
+void open_row_stream(unit_stream *stream, int row_length, int N, int N_s, int M, int stride, int offset, const line_index *index){
+    /* This function opens a stream of all rows of distinct values which add up to M, ordered by their sorted combination.
+    The combinations are split round robin into stride shares, of which the stream yields the permutations of share offset.
+    If an index of the valid lines is given, the combinations are taken from it instead of being enumerated.
+    */
+    stream->row_length = row_length;
+    stream->stride = stride;
+    stream->offset = offset;
+    stream->N = N;
+    stream->N_s = N_s;
+    stream->M = M;
+    stream->generated = true;
+    stream->exhausted = false;
+    // The first position starts below the smallest value, so the first increase tries it
+    stream->combination[0] = N_s - 1;
+    stream->sums[0] = 0;
+    stream->depth = 0;
+    stream->combinations = 0;
+    stream->sets = index != NULL ? index->sets[row_length] : NULL;
+    stream->set_cnt = index != NULL ? index->set_cnt[row_length] : 0;
+    stream->has_row = false;
+    init_row_buffer(&stream->units, row_length);
+    stream->borrowed = false;
+    stream->next = 0;
+    stream->cnt = 0;
+}
+
+void open_buffer_stream(unit_stream *stream, row_buffer *units, int stride, int offset){
+    /* This function opens a stream of the precomputed units, of which it yields the ones whose index is offset modulo stride.
+    The stream takes over the list and frees it once it is closed.
+    */
+    stream->row_length = units->row_length;
+    stream->stride = stride;
+    stream->offset = offset;
+    stream->generated = false;
+    stream->sets = NULL;
+    stream->exhausted = false;
+    stream->has_row = false;
+    stream->units = *units;
+    stream->next = offset;
+    stream->cnt = 0;
+    stream->borrowed = false;
+    init_row_buffer(units, units->row_length);
+}
+
+void open_borrowed_stream(unit_stream *stream, const row_buffer *units, int stride, int offset){
+    /* This function opens a stream of the precomputed units like open_buffer_stream, but only reads them in place.
+    The list stays with the caller, which must keep it until the stream is closed and release it afterwards.
+    */
+    row_buffer view = *units;
+    open_buffer_stream(stream, &view, stride, offset);
+    stream->borrowed = true;
+}
+
+int next_units(unit_stream *stream, int max_cnt, row_buffer *batch){
+    /* This function replaces the rows of batch with the next at most max_cnt work units of the stream.
+    It returns the number of work units in the batch, which is 0 once the stream is exhausted.
+    */
+    int L = stream->row_length;
+    batch->cnt = 0;
+    reserve_rows(batch, max_cnt);
+
+    if (!stream->generated){
+        while (batch->cnt < max_cnt && stream->next < stream->units.cnt){
+            append_row(batch, stream->units.values + (size_t)stream->next * L);
+            stream->next += stream->stride;
+        }
+        stream->cnt += batch->cnt;
+        return batch->cnt;
+    }
+
+    while (batch->cnt < max_cnt && !stream->exhausted){
+        if (stream->has_row){
+            append_row(batch, stream->row);
+            stream->has_row = next_permutation(stream->row, L);
+            continue;
+        }
+        // Find the next combination of our share and start with its sorted permutation
+        if (!next_combination(stream)){
+            stream->exhausted = true;
+            break;
+        }
+        if (stream->combinations++ % stream->stride != stream->offset)
+            continue;
+        memcpy(stream->row, stream->combination, L * sizeof(int));
+        stream->has_row = true;
+    }
+    stream->cnt += batch->cnt;
+    return batch->cnt;
+}
+
+void close_stream(unit_stream *stream){
+    /* This function releases the memory held by a stream, borrowed units are left to their owner.
+    */
+    if (!stream->borrowed)
+        free_row_buffer(&stream->units);
+}
+
+long long build_frontier(const search_state *root, int engine, int depth, int target, row_buffer *units){
+    /* This function expands the search below root level by level, branching on the same tiles with the same candidate values as the selected engine, and appends the reached partial boards to units.
+    The expansion stops after depth levels or as soon as there are at least target boards (0 for no limit), and boards which are already complete are kept as they are.
+    It returns the number of placed tiles, which the engine would have counted for these levels.
+    */
+    int N = root->layout->N;
+    int i, k, cell, pos, level;
+    long long nodes = 0;
+    int board[N];
+    row_buffer current, next;
+
+    init_row_buffer(&current, N);
+    append_row(&current, root->cells);
+    for (level = 0; level < depth; level++){
+        if (target > 0 && current.cnt >= target)
+            break;
+        init_row_buffer(&next, N);
+        bool expanded = false;
+        for (i = 0; i < current.cnt; i++){
+            const int *cells = current.values + (size_t)i * N;
+            // Once the target is reached the remaining boards of the level are kept unexpanded
+            if (target > 0 && next.cnt + current.cnt - i >= target){
+                append_row(&next, cells);
+                continue;
+            }
+            // Rebuild the search state of the board from the root, so the line sums are up to date
+            search_state s = *root;
+            for (k = 0; k < N; k++){
+                if (root->cells[k] == 0 && cells[k] > 0)
+                    place_tile(&s, k, cells[k]);
+            }
+            pos = 0;
+            cell = next_tile(&s, engine, &pos);
+            if (cell < 0){
+                append_row(&next, cells);
+                continue;
+            }
+            // Every candidate value of the tile gives a board of the next level
+            memcpy(board, cells, N * sizeof(int));
+            valset_t candidates = tile_candidates(&s, cell);
+            while (candidates){
+                k = valset_first(candidates);
+                candidates &= candidates - 1;
+                board[cell] = k + root->N_s;
+                append_row(&next, board);
+                nodes++;
+            }
+            expanded = true;
+        }
+        free_row_buffer(&current);
+        current = next;
+        if (!expanded)
+            break;
+    }
+
+    for (i = 0; i < current.cnt; i++){
+        append_row(units, current.values + (size_t)i * N);
+    }
+    free_row_buffer(&current);
+    return nodes;
+}
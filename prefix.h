@@ -0,0 +1,65 @@
+#ifndef PREFIX_H
+#define PREFIX_H
+
+#include <stdbool.h>
+
+#include "board.h"
+#include "search.h"
+#include "lines.h"
+
+// A growing list of rows of equal length
+typedef struct {
+    int *values;
+    int cnt, capacity, row_length;
+} row_buffer;
+
+// A stream of work units, which are either generated rows of distinct values adding up to M or taken from a list of precomputed ones.
+// Only every stride-th row combination or precomputed unit, starting at offset, belongs to the stream.
+typedef struct {
+    int row_length;
+    int stride, offset;
+    // The bounds of the generated rows
+    int N, N_s, M;
+    bool generated, exhausted;
+    // The current sorted combination, the sums of its first positions and the number of positions fixed
+    int combination[HEX_MAX_ROWS];
+    int sums[HEX_MAX_ROWS + 1];
+    int depth;
+    // Number of combinations enumerated so far
+    long long combinations;
+    // The combinations of the index of the valid lines if one is used instead of enumerating them, and their number
+    const valset_t *sets;
+    long long set_cnt;
+    // The next permutation of the current combination, if there is one
+    int row[HEX_MAX_ROWS];
+    bool has_row;
+    // The precomputed units and the index of the next one
+    row_buffer units;
+    int next;
+    // Whether the precomputed units lie in memory the stream doesn't own, like a window shared by the processes of a node
+    bool borrowed;
+    // Number of work units taken from the stream so far
+    long long cnt;
+} unit_stream;
+
+void init_row_buffer(row_buffer *buffer, int row_length);
+
+void reserve_rows(row_buffer *buffer, int cnt);
+
+void append_row(row_buffer *buffer, const int *row);
+
+void free_row_buffer(row_buffer *buffer);
+
+void open_row_stream(unit_stream *stream, int row_length, int N, int N_s, int M, int stride, int offset, const line_index *index);
+
+void open_buffer_stream(unit_stream *stream, row_buffer *units, int stride, int offset);
+
+void open_borrowed_stream(unit_stream *stream, const row_buffer *units, int stride, int offset);
+
+int next_units(unit_stream *stream, int max_cnt, row_buffer *batch);
+
+void close_stream(unit_stream *stream);
+
+long long build_frontier(const search_state *root, int engine, int depth, int target, row_buffer *units);
+
+#endif
@@ -0,0 +1,123 @@
+/*Here you can find the table of results per work unit, which shows how the solutions and the search effort are spread over the work units.
+Every process records the work units it solved, the table is then gathered on the first process and written as CSV with one line per work unit.
+Work units which take much longer than the others are the ones which keep processes idle at the end of a search, so they are worth splitting further.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <mpi.h>
+
+#include "results.h"
+
+void init_unit_table(unit_table *table, int row_length){
+    /* This function initializes an empty table of work units of the given length.
+    */
+    init_row_buffer(&table->units, row_length);
+    table->rank = NULL;
+    table->sol_cnt = NULL;
+    table->nodes = NULL;
+    table->seconds = NULL;
+    table->capacity = 0;
+}
+
+static void reserve_results(unit_table *table, int cnt){
+    /* This function makes sure the table can hold the results of cnt work units.
+    */
+    reserve_rows(&table->units, cnt);
+    if (cnt <= table->capacity)
+        return;
+    int capacity = table->units.capacity;
+    table->rank = realloc(table->rank, capacity * sizeof(int));
+    table->sol_cnt = realloc(table->sol_cnt, capacity * sizeof(long long));
+    table->nodes = realloc(table->nodes, capacity * sizeof(long long));
+    table->seconds = realloc(table->seconds, capacity * sizeof(double));
+    if (table->rank == NULL || table->sol_cnt == NULL || table->nodes == NULL || table->seconds == NULL){
+        printf("Could not allocate memory for the results of %d work units!\n", capacity);
+        exit(-1);
+    }
+    table->capacity = capacity;
+}
+
+void add_unit_result(unit_table *table, const int *unit, int rank, long long sol_cnt, long long nodes, double seconds){
+    /* This function appends the results of a solved work unit to the table. It is not thread safe.
+    */
+    int k = table->units.cnt;
+    reserve_results(table, k + 1);
+    append_row(&table->units, unit);
+    table->rank[k] = rank;
+    table->sol_cnt[k] = sol_cnt;
+    table->nodes[k] = nodes;
+    table->seconds[k] = seconds;
+}
+
+void gather_unit_table(unit_table *table){
+    /* This function collects the tables of all processes on the first process, ordered by rank. The tables of the other processes are left unchanged.
+    */
+    int comm_sz, my_rank, k;
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    int row_length = table->units.row_length;
+    int cnt = table->units.cnt;
+
+    int counts[comm_sz], offsets[comm_sz], value_counts[comm_sz], value_offsets[comm_sz];
+    MPI_Gather(&cnt, 1, MPI_INT, counts, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    unit_table all;
+    init_unit_table(&all, row_length);
+    if (my_rank == 0){
+        int total = 0;
+        for (k = 0; k < comm_sz; k++){
+            offsets[k] = total;
+            value_counts[k] = counts[k] * row_length;
+            value_offsets[k] = total * row_length;
+            total += counts[k];
+        }
+        reserve_results(&all, total);
+        all.units.cnt = total;
+    }
+
+    MPI_Gatherv(table->units.values, cnt * row_length, MPI_INT, all.units.values, value_counts, value_offsets, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(table->rank, cnt, MPI_INT, all.rank, counts, offsets, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(table->sol_cnt, cnt, MPI_LONG_LONG, all.sol_cnt, counts, offsets, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(table->nodes, cnt, MPI_LONG_LONG, all.nodes, counts, offsets, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(table->seconds, cnt, MPI_DOUBLE, all.seconds, counts, offsets, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    if (my_rank == 0){
+        free_unit_table(table);
+        *table = all;
+    }
+}
+
+bool write_unit_table(const unit_table *table, const char *path){
+    /* This function writes the table as CSV, where the values of a work unit are separated by spaces and empty tiles of frontier boards are 0.
+    It returns false if the file could not be written.
+    */
+    int k, j;
+    int row_length = table->units.row_length;
+    FILE *file = fopen(path, "w");
+    if (file == NULL){
+        printf("Could not write the results of the work units to %s!\n", path);
+        return false;
+    }
+    fprintf(file, "rank,unit,solutions,nodes,seconds\n");
+    for (k = 0; k < table->units.cnt; k++){
+        fprintf(file, "%d,", table->rank[k]);
+        for (j = 0; j < row_length; j++){
+            fprintf(file, "%d%s", table->units.values[(size_t)k * row_length + j], j < row_length - 1 ? " " : "");
+        }
+        fprintf(file, ",%lld,%lld,%lf\n", table->sol_cnt[k], table->nodes[k], table->seconds[k]);
+    }
+    fclose(file);
+    return true;
+}
+
+void free_unit_table(unit_table *table){
+    /* This function releases the memory of the table.
+    */
+    free_row_buffer(&table->units);
+    free(table->rank);
+    free(table->sol_cnt);
+    free(table->nodes);
+    free(table->seconds);
+    init_unit_table(table, table->units.row_length);
+}
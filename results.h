@@ -0,0 +1,28 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include <stdbool.h>
+
+#include "prefix.h"
+
+// The results of the solved work units, one entry per work unit in the order they were solved.
+// The process which solved a work unit, its solutions, placed tiles and the seconds spent on it are stored next to the work unit itself.
+typedef struct {
+    row_buffer units;
+    int *rank;
+    long long *sol_cnt, *nodes;
+    double *seconds;
+    int capacity;
+} unit_table;
+
+void init_unit_table(unit_table *table, int row_length);
+
+void add_unit_result(unit_table *table, const int *unit, int rank, long long sol_cnt, long long nodes, double seconds);
+
+void gather_unit_table(unit_table *table);
+
+bool write_unit_table(const unit_table *table, const char *path);
+
+void free_unit_table(unit_table *table);
+
+#endif
@@ -0,0 +1,297 @@
+/*Here you can find the dynamic distribution of work units among the MPI processes.
+Instead of splitting the work units into equally sized blocks up front, the first process acts as a scheduler and hands out chunks of consecutive work units to the other processes whenever they ask for more work.
+This way processes which got cheap work units come back earlier and take over more of the remaining ones.
+As the scheduler knows which work units are completed, it also keeps the checkpoint of the search.
+The scheduler is also the producer of the work units: while no process is waiting, it takes the next chunks from the stream of work units into a bounded queue, so generating and solving overlap and only the queued chunks are held in memory.
+
+Here you can also find the early termination while searching for the first solution. A process which finds one sends a stop message to all other processes, which poll for it while searching and then let their threads stop through search_stop.
+Once the search is over, all processes learn who found a solution and receive the stop messages which are still pending, so no message is left over for the next search.
+
+If the cost of every work unit was estimated, the work units can also be packed before they are distributed: the most expensive work units go first, each to the process with the least work so far.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <mpi.h>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "schedule.h"
+#include "search.h"
+
+// A work unit and its estimated cost, which are sorted together
+typedef struct {
+    double cost;
+    int index;
+} unit_cost;
+
+// A chunk of work units together with their indexes in the stream
+typedef struct {
+    row_buffer rows;
+    long long *index;
+} work_chunk;
+
+// Whether this process sent its stop messages, and from which processes it received one during the current search
+static bool stop_announced = false;
+static bool *stop_received = NULL;
+
+static int produce_chunk(unit_stream *stream, int chunk_size, const checkpoint *cp, work_chunk *chunk){
+    /* This function fills the chunk with the next at most chunk_size work units of the stream which the checkpoint doesn't list as completed.
+    It returns their number, which is 0 once the stream is exhausted.
+    */
+    int k, kept;
+    int row_length = stream->row_length;
+    do{
+        // The stream isn't split, so the index of a work unit is the number of units taken before it
+        long long first = stream->cnt;
+        if (next_units(stream, chunk_size, &chunk->rows) == 0)
+            return 0;
+        kept = 0;
+        for (k = 0; k < chunk->rows.cnt; k++){
+            if (unit_done(cp, first + k))
+                continue;
+            memmove(chunk->rows.values + (size_t)kept * row_length, chunk->rows.values + (size_t)k * row_length, row_length * sizeof(int));
+            chunk->index[kept++] = first + k;
+        }
+        chunk->rows.cnt = kept;
+    } while (kept == 0);
+    return kept;
+}
+
+void serve_chunks(unit_stream *stream, int chunk_size, int queue_size, int comm_sz, checkpoint *cp){
+    /* This function hands out the work units of the stream in chunks of chunk_size to all other processes until none are left.
+    At most queue_size chunks are produced ahead of the requests. Every process gets an empty chunk once the stream is exhausted, after which it doesn't ask again.
+    Work units the checkpoint lists as completed are skipped. A process reports the results of its previous chunk with each request, which completes its work units in the checkpoint, and the checkpoint is written in between requests.
+    */
+    int active = comm_sz - 1;
+    int flag, k, source;
+    long long report[3];
+    int row_length = stream->row_length;
+    MPI_Status status;
+
+    // A ring of prepared chunks, head is the oldest one
+    work_chunk *queue = malloc(queue_size * sizeof(work_chunk));
+    int head = 0, queued = 0;
+    bool exhausted = false;
+    for (k = 0; k < queue_size; k++){
+        init_row_buffer(&queue[k].rows, row_length);
+        queue[k].index = malloc(chunk_size * sizeof(long long));
+    }
+    // The indexes of the work units each process is solving at the moment
+    long long *working = malloc((size_t)comm_sz * chunk_size * sizeof(long long));
+    int working_cnt[comm_sz];
+    for (k = 0; k < comm_sz; k++){
+        working_cnt[k] = 0;
+    }
+
+    while (active > 0){
+        // Stop handing out work units once a process found the first solution
+        poll_cancellation();
+        if (search_stopped()){
+            exhausted = true;
+            queued = 0;
+        }
+        // Check whether any process asks for work
+        MPI_Iprobe(MPI_ANY_SOURCE, TAG_REQUEST, MPI_COMM_WORLD, &flag, &status);
+        if (!flag){
+            // Nobody is waiting, so fill the queue or wait for the next request once it is full
+            if (!exhausted && queued < queue_size){
+                if (produce_chunk(stream, chunk_size, cp, &queue[(head + queued) % queue_size]) > 0)
+                    queued++;
+                else
+                    exhausted = true;
+            }
+            else{
+                MPI_Probe(MPI_ANY_SOURCE, TAG_REQUEST, MPI_COMM_WORLD, &status);
+            }
+            continue;
+        }
+        source = status.MPI_SOURCE;
+        MPI_Recv(report, 3, MPI_LONG_LONG, source, TAG_REQUEST, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        // The previous chunk of the process is completed, unless it was skipped after the first solution was found
+        if (!search_stopped()){
+            for (k = 0; k < working_cnt[source]; k++){
+                complete_unit(cp, working[(size_t)source * chunk_size + k]);
+            }
+            add_checkpoint_results(cp, report[0], report[1], report[2]);
+            update_checkpoint(cp, false);
+        }
+        working_cnt[source] = 0;
+
+        // The process would have to wait for the queue, so produce its chunk right away
+        if (queued == 0 && !exhausted){
+            if (produce_chunk(stream, chunk_size, cp, &queue[head]) > 0)
+                queued++;
+            else
+                exhausted = true;
+        }
+        if (queued > 0){
+            MPI_Send(queue[head].rows.values, queue[head].rows.cnt * row_length, MPI_INT, source, TAG_WORK, MPI_COMM_WORLD);
+            memcpy(working + (size_t)source * chunk_size, queue[head].index, queue[head].rows.cnt * sizeof(long long));
+            working_cnt[source] = queue[head].rows.cnt;
+            head = (head + 1) % queue_size;
+            queued--;
+        }
+        else{
+            // Tell the process to stop
+            MPI_Send(NULL, 0, MPI_INT, source, TAG_WORK, MPI_COMM_WORLD);
+            active--;
+        }
+    }
+    update_checkpoint(cp, true);
+
+    for (k = 0; k < queue_size; k++){
+        free_row_buffer(&queue[k].rows);
+        free(queue[k].index);
+    }
+    free(queue);
+    free(working);
+}
+
+bool request_chunk(row_buffer *chunk, const long long *report){
+    /* This function reports the number of solutions, of solutions including symmetric ones and of placed tiles of the previous chunk to the scheduler and asks it for the next chunk of work units, which is stored in chunk.
+    It returns false if no work units are left.
+    */
+    int size;
+    MPI_Status status;
+    MPI_Send(report, 3, MPI_LONG_LONG, 0, TAG_REQUEST, MPI_COMM_WORLD);
+    // The chunk size is only known once the message arrives
+    MPI_Probe(0, TAG_WORK, MPI_COMM_WORLD, &status);
+    MPI_Get_count(&status, MPI_INT, &size);
+    chunk->cnt = size / chunk->row_length;
+    reserve_rows(chunk, chunk->cnt);
+    MPI_Recv(chunk->values, size, MPI_INT, 0, TAG_WORK, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    return chunk->cnt > 0;
+}
+
+void start_cancellation(void){
+    /* This function prepares the early termination of a search for the first solution and lets the engines poll for stop messages.
+    */
+    int comm_sz, k;
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    free(stop_received);
+    stop_received = malloc(comm_sz * sizeof(bool));
+    for (k = 0; k < comm_sz; k++){
+        stop_received[k] = false;
+    }
+    stop_announced = false;
+    set_search_stop(false);
+    search_poll = poll_cancellation;
+}
+
+void poll_cancellation(void){
+    /* This function receives the pending stop messages and tells the threads to stop if there were any.
+    If a thread of this process already stopped the search without a stop message, it found a solution, which is announced right away instead of once the threads are done.
+    As MPI is only used by the main thread, the other threads return immediately.
+    */
+    int comm_sz, flag, stop, k;
+    MPI_Status status;
+    // Nothing to do if we search for all solutions
+    if (stop_received == NULL)
+        return;
+    #ifdef _OPENMP
+        if (omp_get_thread_num() != 0)
+            return;
+    #endif
+    if (search_stopped() && !stop_announced){
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+        for (k = 0; k < comm_sz && !stop_received[k]; k++);
+        if (k == comm_sz)
+            announce_solution();
+    }
+    MPI_Iprobe(MPI_ANY_SOURCE, TAG_STOP, MPI_COMM_WORLD, &flag, &status);
+    while (flag){
+        MPI_Recv(&stop, 1, MPI_INT, status.MPI_SOURCE, TAG_STOP, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        stop_received[status.MPI_SOURCE] = true;
+        set_search_stop(true);
+        MPI_Iprobe(MPI_ANY_SOURCE, TAG_STOP, MPI_COMM_WORLD, &flag, &status);
+    }
+}
+
+void announce_solution(void){
+    /* This function sends a stop message to all other processes, once per search.
+    */
+    int comm_sz, my_rank, k, stop = 1;
+    if (stop_announced)
+        return;
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Request requests[comm_sz];
+    for (k = 0; k < comm_sz; k++){
+        if (k == my_rank)
+            requests[k] = MPI_REQUEST_NULL;
+        else
+            MPI_Isend(&stop, 1, MPI_INT, k, TAG_STOP, MPI_COMM_WORLD, &requests[k]);
+    }
+    MPI_Waitall(comm_sz, requests, MPI_STATUSES_IGNORE);
+    stop_announced = true;
+    set_search_stop(true);
+}
+
+int finish_cancellation(void){
+    /* This function ends the early termination of a search and returns the smallest rank of the processes which found a solution, or -1 if none did.
+    The stop messages not received yet are received from their senders directly, so they can't be mistaken for ones of the next search.
+    */
+    int comm_sz, my_rank, k, stop, first = -1;
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    search_poll = NULL;
+
+    int announced[comm_sz];
+    int local = stop_announced;
+    MPI_Allgather(&local, 1, MPI_INT, announced, 1, MPI_INT, MPI_COMM_WORLD);
+    for (k = 0; k < comm_sz; k++){
+        if (!announced[k])
+            continue;
+        if (first < 0)
+            first = k;
+        if (k != my_rank && !stop_received[k])
+            MPI_Recv(&stop, 1, MPI_INT, k, TAG_STOP, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+    free(stop_received);
+    stop_received = NULL;
+    set_search_stop(false);
+    return first;
+}
+
+static int compare_costs(const void *a, const void *b){
+    /* This function orders the work units by decreasing cost, work units of equal cost by their index.
+    */
+    const unit_cost *x = a, *y = b;
+    if (x->cost != y->cost)
+        return x->cost < y->cost ? 1 : -1;
+    return x->index - y->index;
+}
+
+void pack_work_units(const row_buffer *units, const double *cost, int parts, int part, double *loads, row_buffer *packed){
+    /* This function splits the work units into parts of about equal cost, from the most to the least expensive work unit each is added to the part with the lowest cost so far.
+    The work units of the given part are put into packed, starting with the most expensive one, and loads is set to the cost of every part. The work units themselves are only read, so they can lie in memory shared with other processes.
+    As all processes pack the same costs the same way, they agree on the parts without communicating.
+    */
+    int L = units->row_length;
+    int i, k, lightest;
+    unit_cost *order = malloc((units->cnt > 0 ? units->cnt : 1) * sizeof(unit_cost));
+    for (i = 0; i < units->cnt; i++){
+        order[i].cost = cost[i];
+        order[i].index = i;
+    }
+    qsort(order, units->cnt, sizeof(unit_cost), compare_costs);
+
+    init_row_buffer(packed, L);
+    for (k = 0; k < parts; k++){
+        loads[k] = 0.0;
+    }
+    for (i = 0; i < units->cnt; i++){
+        lightest = 0;
+        for (k = 1; k < parts; k++){
+            if (loads[k] < loads[lightest])
+                lightest = k;
+        }
+        loads[lightest] += order[i].cost;
+        if (lightest == part)
+            append_row(packed, units->values + (size_t)order[i].index * L);
+    }
+    free(order);
+}
@@ -0,0 +1,30 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdbool.h>
+
+#include "prefix.h"
+#include "checkpoint.h"
+
+// Message tags of the dynamic distribution of work units
+#define TAG_REQUEST 1
+#define TAG_WORK 2
+// Message tags of the early termination once the first solution is found
+#define TAG_STOP 3
+#define TAG_SOLUTION 4
+
+void serve_chunks(unit_stream *stream, int chunk_size, int queue_size, int comm_sz, checkpoint *cp);
+
+bool request_chunk(row_buffer *chunk, const long long *report);
+
+void start_cancellation(void);
+
+void poll_cancellation(void);
+
+void announce_solution(void);
+
+int finish_cancellation(void);
+
+void pack_work_units(const row_buffer *units, const double *cost, int parts, int part, double *loads, row_buffer *packed);
+
+#endif
@@ -0,0 +1,679 @@
+/*Here you can find the depth first search on the flat board representation.
+The search state keeps a running sum and the number of empty tiles for every line. Placing or removing a tile only touches its three lines, so checking a partial or a complete board takes constant time.
+The unused values are kept in a bitmask, so the values to try at a tile are found by masking and walking the set bits instead of scanning all values.
+
+With symmetry breaking, only boards whose smallest corner is the first tile and whose second corner is smaller than the sixth are searched. Each of the 12 rotations and reflections of a solution satisfies this for exactly one of them.
+
+Two engines are implemented: search_depth_first fills the tiles in row-major order of the first diagonal like the cube solver, while search_propagate completes lines first and fills a line with a single empty tile before branching anywhere else.
+search_iterative visits the tiles in the same order as search_depth_first, but keeps its levels on an explicit stack instead of recursing.
+For the hexagons of side length 2 to 5 both engines are also compiled with the number of tiles and the line tables as constants, see search_kernel.h, and search_engine selects these kernels unless disabled.
+Either of them can be split into OpenMP tasks for the first levels of the search by search_tasks, where each task works on its own copy of the search state.
+While searching for the first solution, all engines return as soon as search_stop is set by another thread or process which found one.
+Optionally, the recursive engines look up every remaining board in a table of the boards their thread already searched, see memo.c.
+*/
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "helpers.h"
+#include "board.h"
+#include "search.h"
+#include "stats.h"
+#include "sink.h"
+#include "memo.h"
+#include "search_tables.h"
+
+bool search_stop = false;
+void (*search_poll)(void) = NULL;
+long long poll_placed = 0;
+
+void init_search_state(search_state *s, const board_layout *layout, int N_s, int M, bool check_partial, bool find_all, bool print_solutions, bool symmetry){
+    /* This function initializes an empty board with all values unused.
+    */
+    int i;
+    s->layout = layout;
+    s->N_s = N_s;
+    s->M = M;
+    s->check_partial = check_partial;
+    s->find_all = find_all;
+    s->print_solutions = print_solutions;
+    // A single tile has no distinct corners to order
+    s->symmetry = symmetry && layout->n > 1;
+    s->specialized = true;
+    s->sol_cnt = 0;
+    s->sol_expanded = 0;
+    s->nodes = 0;
+    s->order_length = 0;
+    s->lines_wrong = 0;
+    s->lines_one_free = 0;
+    s->index = NULL;
+    s->memo = false;
+    s->key = 0;
+    s->available = valset_range(0, layout->N - 1);
+    for (i = 0; i < layout->N; i++){
+        s->cells[i] = 0;
+    }
+    for (i = 0; i < layout->nr_lines; i++){
+        s->line_sum[i] = 0;
+        s->line_values[i] = 0;
+        s->line_free[i] = layout->line_length[i];
+        if (s->line_free[i] == 1)
+            s->lines_one_free |= (uint64_t)1 << i;
+    }
+    // i other tiles sum up to at least the i smallest and at most the i largest values
+    int N_e = N_s + layout->N - 1;
+    for (i = 0; i <= layout->r; i++){
+        s->min_rest[i] = i*N_s + i*(i-1)/2;
+        s->max_rest[i] = i*N_e - i*(i-1)/2;
+    }
+}
+
+// The line tables the inline updates read, either the ones of the layout of the search state or the static ones of a kernel
+typedef struct {
+    const unsigned char (*cell_lines)[3];
+    const unsigned char *line_length;
+    const unsigned short *line_start;
+    const unsigned char *line_cells;
+} line_tables;
+
+#define LAYOUT_TABLES(s) ((line_tables){(s)->layout->cell_lines, (s)->layout->line_length, (s)->layout->line_start, (s)->layout->line_cells})
+
+static inline __attribute__((always_inline)) void place_tile_inline(search_state *s, line_tables t, int cell, int value){
+    /* This function sets a value on an empty tile and updates the three lines the tile is in.
+    */
+    int i, line;
+    s->cells[cell] = value;
+    s->available &= ~((valset_t)1 << (value - s->N_s));
+    // An empty tile becomes set, a value used and three line sums change
+    if (s->memo)
+        s->key ^= memo_cell_key(cell) ^ memo_value_key(value - s->N_s);
+    for (i = 0; i < 3; i++){
+        line = t.cell_lines[cell][i];
+        if (s->memo)
+            s->key ^= memo_line_key(line, s->line_sum[line]) ^ memo_line_key(line, s->line_sum[line] + value);
+        s->line_sum[line] += value;
+        s->line_values[line] |= (valset_t)1 << (value - s->N_s);
+        s->line_free[line]--;
+        // Remember if the line got completed with the wrong sum
+        if (s->line_free[line] == 0 && s->line_sum[line] != s->M)
+            s->lines_wrong++;
+        // Keep track of the lines with exactly one empty tile
+        if (s->line_free[line] <= 1)
+            s->lines_one_free ^= (uint64_t)1 << line;
+    }
+}
+
+static inline __attribute__((always_inline)) void remove_tile_inline(search_state *s, line_tables t, int cell){
+    /* This function clears a tile and reverts the updates place_tile did on its three lines.
+    */
+    int i, line;
+    int value = s->cells[cell];
+    if (s->memo)
+        s->key ^= memo_cell_key(cell) ^ memo_value_key(value - s->N_s);
+    for (i = 0; i < 3; i++){
+        line = t.cell_lines[cell][i];
+        if (s->memo)
+            s->key ^= memo_line_key(line, s->line_sum[line]) ^ memo_line_key(line, s->line_sum[line] - value);
+        if (s->line_free[line] == 0 && s->line_sum[line] != s->M)
+            s->lines_wrong--;
+        if (s->line_free[line] <= 1)
+            s->lines_one_free ^= (uint64_t)1 << line;
+        s->line_sum[line] -= value;
+        s->line_values[line] &= ~((valset_t)1 << (value - s->N_s));
+        s->line_free[line]++;
+    }
+    s->available |= (valset_t)1 << (value - s->N_s);
+    s->cells[cell] = 0;
+}
+
+static inline __attribute__((always_inline)) valset_t candidate_values_inline(const search_state *s, line_tables t, int cell){
+    /* This function returns the unused values which keep the three lines of an empty tile able to reach M.
+    After placing a value v in a line with sum and free empty tiles, the other free - 1 tiles have to add up to M - sum - v, which bounds v from both sides.
+    */
+    int i, line, rest, lo, hi;
+    valset_t candidates = s->available;
+    for (i = 0; i < 3; i++){
+        line = t.cell_lines[cell][i];
+        rest = s->M - s->line_sum[line] - s->N_s;
+        lo = rest - s->max_rest[s->line_free[line] - 1];
+        hi = rest - s->min_rest[s->line_free[line] - 1];
+        candidates &= valset_range(lo, hi);
+    }
+    return candidates;
+}
+
+void place_tile(search_state *s, int cell, int value){
+    /* This function sets a value on an empty tile and updates the three lines the tile is in.
+    */
+    place_tile_inline(s, LAYOUT_TABLES(s), cell, value);
+}
+
+void remove_tile(search_state *s, int cell){
+    /* This function clears a tile and reverts the updates place_tile did on its three lines.
+    */
+    remove_tile_inline(s, LAYOUT_TABLES(s), cell);
+}
+
+void enable_memo(search_state *s){
+    /* This function lets the recursive engines look up the remaining boards and computes the key of the board, which place_tile and remove_tile update from now on.
+    The values and the line sum M are part of the key as well, so boards of different searches never share a key.
+    */
+    int i, k;
+    s->memo = true;
+    s->key = memo_mix((uint64_t)s->N_s << 32 | (uint32_t)s->M);
+    for (i = 0; i < s->layout->N; i++){
+        if (s->cells[i] == 0)
+            s->key ^= memo_cell_key(i);
+        else
+            s->key ^= memo_value_key(s->cells[i] - s->N_s);
+    }
+    for (k = 0; k < s->layout->nr_lines; k++){
+        s->key ^= memo_line_key(k, s->line_sum[k]);
+    }
+}
+
+valset_t candidate_values(const search_state *s, int cell){
+    /* This function returns the unused values which keep the three lines of an empty tile able to reach M.
+    */
+    return candidate_values_inline(s, LAYOUT_TABLES(s), cell);
+}
+
+static bool finish_board(search_state *s){
+    /* This function evaluates a board on which all tiles have a value assigned.
+    The board is valid if no line is wrong. If we try to find all solutions, it is counted and printed and false is returned to continue the search.
+    */
+    bool ret = s->lines_wrong == 0;
+    #ifdef HEX_STATS
+        thread_stats.leaves++;
+    #endif
+    if (s->find_all && ret){
+        if (s->print_solutions)
+            sink_solution(s->cells, s->layout->N);
+        s->sol_cnt++;
+        s->sol_expanded += s->symmetry ? count_symmetric_boards(s->layout, s->cells) : 1;
+        return false;
+    }
+    else{
+        return ret;
+    }
+}
+
+static inline __attribute__((always_inline)) bool memo_hit(search_state *s){
+    /* This function returns whether the remaining board was already searched by this thread, in which case its solutions are counted without searching it again.
+    Only boards with enough empty tiles are looked up, and boards with solutions only if these don't have to be printed.
+    */
+    long long cnt;
+    if (!s->memo || valset_count(s->available) < MEMO_MIN_EMPTY || !memo_lookup(s->key, !s->print_solutions, &cnt))
+        return false;
+    s->sol_cnt += cnt;
+    s->sol_expanded += cnt;
+    return true;
+}
+
+static inline __attribute__((always_inline)) void memo_finish(search_state *s, long long found){
+    /* This function stores the number of solutions found below the remaining board, of which found were counted before it was searched, unless the search was stopped before it was complete.
+    */
+    if (s->memo && valset_count(s->available) >= MEMO_MIN_EMPTY && !search_stopped())
+        memo_store(s->key, s->sol_cnt - found);
+}
+
+valset_t symmetry_values(const search_state *s, int cell){
+    /* This function returns the values an empty tile can take without breaking the order of the corners of a canonical board.
+    The first corner has to be smaller than all other corners and the second corner smaller than the sixth.
+    */
+    const board_layout *layout = s->layout;
+    int corner = layout->corner_of[cell];
+    int k, value;
+    int lo = 0, hi = layout->N - 1;
+
+    if (corner < 0)
+        return s->available;
+    if (corner == 0){
+        for (k = 1; k < 6; k++){
+            value = s->cells[layout->corners[k]];
+            if (value > 0 && value - s->N_s - 1 < hi)
+                hi = value - s->N_s - 1;
+        }
+    }
+    else{
+        value = s->cells[layout->corners[0]];
+        if (value > 0)
+            lo = value - s->N_s + 1;
+        if (corner == 1 && s->cells[layout->corners[5]] > 0 && s->cells[layout->corners[5]] - s->N_s - 1 < hi)
+            hi = s->cells[layout->corners[5]] - s->N_s - 1;
+        if (corner == 5 && s->cells[layout->corners[1]] > 0 && s->cells[layout->corners[1]] - s->N_s + 1 > lo)
+            lo = s->cells[layout->corners[1]] - s->N_s + 1;
+    }
+    return s->available & valset_range(lo, hi);
+}
+
+bool validate_symmetry(const search_state *s){
+    /* This function checks whether the corners already set keep the board canonical, which is used to discard precomputed values.
+    */
+    const board_layout *layout = s->layout;
+    int k;
+    int first = s->cells[layout->corners[0]];
+    if (!s->symmetry)
+        return true;
+    for (k = 1; k < 6; k++){
+        if (first > 0 && s->cells[layout->corners[k]] > 0 && s->cells[layout->corners[k]] < first)
+            return false;
+    }
+    if (s->cells[layout->corners[1]] > 0 && s->cells[layout->corners[5]] > 0 && s->cells[layout->corners[5]] < s->cells[layout->corners[1]])
+        return false;
+    return true;
+}
+
+#ifdef HEX_STATS
+static void count_candidate_stats(const search_state *s, int cell, valset_t line_viable, valset_t candidates){
+    /* This function counts the candidate values of an empty tile as nodes and the other values by the reason they are pruned.
+    A value the lines rule out is counted as a wrong complete line if the tile is the last empty one of a line it doesn't complete to M, otherwise as out of reach.
+    */
+    int i, k, line;
+    int N = s->layout->N;
+    count_nodes(N - valset_count(s->available) + 1, valset_count(candidates));
+    thread_stats.prunes[PRUNE_VALUE_USED] += N - valset_count(s->available);
+    thread_stats.prunes[PRUNE_SYMMETRY] += valset_count(line_viable & ~candidates);
+    valset_t pruned = s->available & ~line_viable;
+    while (pruned){
+        k = valset_first(pruned);
+        pruned &= pruned - 1;
+        int reason = PRUNE_SUM_BOUND;
+        for (i = 0; i < 3; i++){
+            line = s->layout->cell_lines[cell][i];
+            if (s->line_free[line] == 1 && s->line_sum[line] + k + s->N_s != s->M)
+                reason = PRUNE_LINE_WRONG;
+        }
+        thread_stats.prunes[reason]++;
+    }
+}
+#endif
+
+static inline __attribute__((always_inline)) valset_t tile_candidates_inline(const search_state *s, line_tables t, int cell){
+    /* This function returns the values to try at an empty tile.
+    These are the unused values, restricted to the ones which can still complete the lines if we check partial solutions and to the canonical ones if we break symmetries.
+    */
+    valset_t candidates = s->check_partial ? candidate_values_inline(s, t, cell) : s->available;
+    // The index knows exactly which values can complete the lines which already have values placed
+    if (s->index != NULL){
+        int i, line;
+        for (i = 0; i < 3 && candidates; i++){
+            line = t.cell_lines[cell][i];
+            if (s->line_values[line] && s->line_free[line] > 1)
+                candidates &= line_index_values(s->index, t.line_length[line], s->line_values[line], s->available);
+        }
+    }
+    #ifdef HEX_STATS
+        valset_t line_viable = candidates;
+    #endif
+    if (s->symmetry)
+        candidates &= symmetry_values(s, cell);
+    #ifdef HEX_STATS
+        count_candidate_stats(s, cell, line_viable, candidates);
+    #endif
+    return candidates;
+}
+
+valset_t tile_candidates(const search_state *s, int cell){
+    /* This function returns the values the engines try at an empty tile.
+    */
+    return tile_candidates_inline(s, LAYOUT_TABLES(s), cell);
+}
+
+static bool search_depth_first_from(search_state *s, int from){
+    /* This function implements search_depth_first, where all tiles before from are already set.
+    The tiles are filled in order, so the next empty tile is searched from the tile after the one placed last instead of from the first tile.
+    */
+    int i, k;
+    int N = s->layout->N;
+    // Give up if the first solution was found elsewhere
+    if (search_stopped())
+        return false;
+    // Find the next empty tile
+    for (i = from; i < N && s->cells[i] > 0; i++);
+    // To this point we only get if all tiles have a value assigned
+    if (i == N)
+        return finish_board(s);
+    // Skip the remaining board if it was searched before
+    if (memo_hit(s))
+        return false;
+    long long found = s->sol_cnt;
+
+    // Try every unused value, which can still complete the lines of the tile if we check partial solutions
+    valset_t candidates = tile_candidates_inline(s, LAYOUT_TABLES(s), i);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        // set it and recurse
+        place_tile(s, i, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+        if (search_depth_first_from(s, i + 1)){
+            return true;
+        }
+        // else reset the tile and try the next available value
+        remove_tile(s, i);
+    }
+    // we couldnt find any value to set, so we have to try a different branch
+    memo_finish(s, found);
+    return false;
+}
+
+bool search_depth_first(search_state *s){
+    /* This function implements the depth first search of solver_depth_first on the search state.
+    The tiles are visited in the same order, but all validity checks use the running line sums and only values which can still complete the lines are tried.
+    */
+    return search_depth_first_from(s, 0);
+}
+
+void plan_search_order(search_state *s){
+    /* This function precomputes the order in which search_propagate branches on the tiles which are empty at the moment.
+    Greedily, the next tile is the one whose emptiest line is closest to being complete, ties are broken by the number of empty tiles over all three of its lines.
+    This way lines get completed early and their last tile gets forced instead of branched on.
+    */
+    const board_layout *layout = s->layout;
+    int line_free[HEX_MAX_LINES];
+    bool planned[HEX_MAX_CELLS];
+    int i, j, cell, best, best_min, best_sum, min_free, sum_free, free;
+
+    for (i = 0; i < layout->nr_lines; i++){
+        line_free[i] = s->line_free[i];
+    }
+    for (i = 0; i < layout->N; i++){
+        planned[i] = s->cells[i] > 0;
+    }
+
+    s->order_length = 0;
+    while (true){
+        best = -1;
+        best_min = 0;
+        best_sum = 0;
+        // Find the empty tile with the most complete lines
+        for (cell = 0; cell < layout->N; cell++){
+            if (planned[cell])
+                continue;
+            min_free = layout->r;
+            sum_free = 0;
+            for (j = 0; j < 3; j++){
+                free = line_free[layout->cell_lines[cell][j]];
+                if (free < min_free)
+                    min_free = free;
+                sum_free += free;
+            }
+            if (best < 0 || min_free < best_min || (min_free == best_min && sum_free < best_sum)){
+                best = cell;
+                best_min = min_free;
+                best_sum = sum_free;
+            }
+        }
+        if (best < 0)
+            break;
+        // Append it to the order and account for it in its lines
+        s->order[s->order_length++] = best;
+        planned[best] = true;
+        for (j = 0; j < 3; j++){
+            line_free[layout->cell_lines[best][j]]--;
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) int propagate_next_tile(const search_state *s, line_tables t, int *pos){
+    /* This function selects the tile search_propagate branches on next, or returns -1 if all tiles are set.
+    A tile which is the last empty one of its line goes first, otherwise the next empty tile of the order is taken and pos is advanced to it.
+    */
+    int i, line;
+
+    if (s->lines_one_free){
+        // Select the empty tile of the first line which has a single one left
+        line = __builtin_ctzll(s->lines_one_free);
+        const unsigned char *line_cells = t.line_cells + t.line_start[line];
+        for (i = 0; s->cells[line_cells[i]] > 0; i++);
+        return line_cells[i];
+    }
+    // Skip the tiles of the order which were forced on the way
+    while (*pos < s->order_length && s->cells[s->order[*pos]] > 0){
+        (*pos)++;
+    }
+    if (*pos == s->order_length)
+        return -1;
+    return s->order[*pos];
+}
+
+bool search_propagate(search_state *s, int pos){
+    /* This function implements a depth first search which completes lines first.
+    If a line has a single empty tile left, its value is fully determined by M and the candidate mask contains only that value if it is still available.
+    Otherwise the search branches on the next empty tile of the order computed by plan_search_order, where all tiles before pos are already set.
+    */
+    int k;
+    // Give up if the first solution was found elsewhere
+    if (search_stopped())
+        return false;
+    int cell = propagate_next_tile(s, LAYOUT_TABLES(s), &pos);
+
+    // To this point we only get if all tiles have a value assigned
+    if (cell < 0)
+        return finish_board(s);
+    // Skip the remaining board if it was searched before
+    if (memo_hit(s))
+        return false;
+    long long found = s->sol_cnt;
+
+    // Try every unused value, which can still complete the lines of the tile if we check partial solutions
+    valset_t candidates = tile_candidates_inline(s, LAYOUT_TABLES(s), cell);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        place_tile(s, cell, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+        if (search_propagate(s, pos)){
+            return true;
+        }
+        remove_tile(s, cell);
+    }
+    memo_finish(s, found);
+    return false;
+}
+
+bool search_iterative(search_state *s, search_stack *stack){
+    /* This function implements the depth first search of search_depth_first without recursion.
+    Each frame of the stack holds a tile and its candidate values which weren't tried yet, so the search continues exactly where it left off when it returns to a frame. The next empty tile is searched from the tile of the frame on instead of from the first tile.
+    The stack can be inspected at any time, as the board always holds the values tried last by all frames.
+    */
+    int N = s->layout->N;
+    int cell, k;
+    search_frame *frame;
+
+    stack->depth = 0;
+    for (cell = 0; cell < N && s->cells[cell] > 0; cell++);
+    // To this point we only get if all tiles have a value assigned
+    if (cell == N)
+        return finish_board(s);
+    stack->frames[0].cell = cell;
+    stack->frames[0].untried = tile_candidates_inline(s, LAYOUT_TABLES(s), cell);
+    stack->depth = 1;
+
+    while (stack->depth > 0){
+        // Give up if the first solution was found elsewhere
+        if (search_stopped())
+            return false;
+        frame = &stack->frames[stack->depth - 1];
+        // Reset the value tried last at this tile
+        if (s->cells[frame->cell] > 0)
+            remove_tile_inline(s, LAYOUT_TABLES(s), frame->cell);
+        // All values were tried, so we have to go back to the previous tile
+        if (!frame->untried){
+            stack->depth--;
+            continue;
+        }
+        k = valset_first(frame->untried);
+        frame->untried &= frame->untried - 1;
+        place_tile_inline(s, LAYOUT_TABLES(s), frame->cell, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+
+        // Find the next empty tile, all tiles before this one are set
+        for (cell = frame->cell + 1; cell < N && s->cells[cell] > 0; cell++);
+        if (cell == N){
+            if (finish_board(s))
+                return true;
+            continue;
+        }
+        stack->frames[stack->depth].cell = cell;
+        stack->frames[stack->depth].untried = tile_candidates_inline(s, LAYOUT_TABLES(s), cell);
+        stack->depth++;
+    }
+    return false;
+}
+
+int next_tile(const search_state *s, int engine, int *pos){
+    /* This function returns the tile the given engine branches on next, or -1 if all tiles are set.
+    */
+    int i;
+    if (engine == ENGINE_PROPAGATE)
+        return propagate_next_tile(s, LAYOUT_TABLES(s), pos);
+    for (i = 0; i < s->layout->N; i++){
+        if (s->cells[i] == 0)
+            return i;
+    }
+    return -1;
+}
+
+// The engines specialized for the common sizes of the hexagon
+#define KERNEL_N 2
+#include "search_kernel.h"
+#undef KERNEL_N
+#define KERNEL_N 3
+#include "search_kernel.h"
+#undef KERNEL_N
+#define KERNEL_N 4
+#include "search_kernel.h"
+#undef KERNEL_N
+#define KERNEL_N 5
+#include "search_kernel.h"
+#undef KERNEL_N
+
+// Compares the line tables compiled into the kernel for side length n with the layout
+#define KERNEL_TABLES_MATCH(n) \
+    case n: \
+        return layout->N == (int)(sizeof(kernel_cell_lines_n##n) / sizeof(kernel_cell_lines_n##n[0])) \
+            && layout->nr_lines == (int)(sizeof(kernel_line_length_n##n) / sizeof(kernel_line_length_n##n[0])) \
+            && memcmp(layout->cell_lines, kernel_cell_lines_n##n, sizeof(kernel_cell_lines_n##n)) == 0 \
+            && memcmp(layout->line_length, kernel_line_length_n##n, sizeof(kernel_line_length_n##n)) == 0 \
+            && memcmp(layout->line_start, kernel_line_start_n##n, sizeof(kernel_line_start_n##n)) == 0 \
+            && memcmp(layout->line_cells, kernel_line_cells_n##n, sizeof(kernel_line_cells_n##n)) == 0;
+
+bool kernel_tables_match(const board_layout *layout){
+    /* This function checks that the line tables of search_tables.h hold the same values as the layout computed by init_board_layout.
+    Sizes without a specialized kernel have no tables and always match.
+    */
+    switch (layout->n){
+        KERNEL_TABLES_MATCH(2)
+        KERNEL_TABLES_MATCH(3)
+        KERNEL_TABLES_MATCH(4)
+        KERNEL_TABLES_MATCH(5)
+    }
+    return true;
+}
+
+// Runs the engine specialized for side length n
+#define SPECIALIZED_ENGINE(n) \
+    case n: \
+        if (engine == ENGINE_PROPAGATE) \
+            return search_propagate_n##n(s, pos); \
+        return search_depth_first_n##n(s, 0);
+
+bool search_engine(search_state *s, int engine, int pos){
+    /* This function runs the selected engine on the remaining empty tiles.
+    If there is a kernel specialized for the size of the hexagon and it is enabled, it is used instead of the generic engine.
+    */
+    if (engine == ENGINE_ITERATIVE){
+        search_stack stack;
+        return search_iterative(s, &stack);
+    }
+    if (s->specialized){
+        switch (s->layout->n){
+            SPECIALIZED_ENGINE(2)
+            SPECIALIZED_ENGINE(3)
+            SPECIALIZED_ENGINE(4)
+            SPECIALIZED_ENGINE(5)
+        }
+    }
+    if (engine == ENGINE_PROPAGATE)
+        return search_propagate(s, pos);
+    return search_depth_first(s);
+}
+
+static void merge_task_results(task_results *res, const search_state *s, long long nodes, double seconds, bool ret){
+    /* This function adds the results of a task which searched for the given seconds to the shared results. If the task found a solution while searching for the first one, its board is stored.
+    */
+    int k;
+    #ifdef _OPENMP
+        #pragma omp critical(task_results)
+    #endif
+    {
+        res->sol_cnt += s->sol_cnt;
+        res->sol_expanded += s->sol_expanded;
+        res->nodes += nodes;
+        res->seconds += seconds;
+        if (ret && !res->found){
+            for (k = 0; k < s->layout->N; k++){
+                res->cells[k] = s->cells[k];
+            }
+            res->found = true;
+        }
+    }
+    // Let the other tasks know that they can stop and the other processes learn about the solution right away
+    if (ret){
+        set_search_stop(true);
+        if (search_poll != NULL)
+            search_poll();
+    }
+    // Every task has its own search state, so the placements of all tasks of the thread count towards the next poll
+    else
+        poll_placements(nodes);
+}
+
+void search_tasks(search_state *s, int engine, int pos, int depth, task_results *res){
+    /* This function splits the search below the given board into OpenMP tasks.
+    Until depth levels below the board, every candidate value of the next tile is placed on a private copy of the search state which is handed to a new task. Below that, the engine runs sequentially on the copy.
+    The results of all tasks are added to res. Tasks which start after a first solution has been found return immediately.
+    */
+    int k, cell;
+    bool found;
+
+    #ifdef _OPENMP
+        #pragma omp atomic read
+    #endif
+    found = res->found;
+    if (found || search_stopped())
+        return;
+
+    cell = depth > 0 ? next_tile(s, engine, &pos) : -1;
+    if (cell < 0){
+        // Solve the remaining tiles sequentially and add the results
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bool ret = search_engine(s, engine, pos);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        merge_task_results(res, s, s->nodes, get_time_diff(start, end), ret);
+        return;
+    }
+
+    valset_t candidates = tile_candidates_inline(s, LAYOUT_TABLES(s), cell);
+    // Count the placements of this level, the tasks count the ones below
+    merge_task_results(res, s, valset_count(candidates), 0.0, false);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        // Each task gets its own copy of the board with the candidate placed
+        search_state child = *s;
+        place_tile(&child, cell, k + s->N_s);
+        #ifdef _OPENMP
+            #pragma omp task firstprivate(child, pos) shared(res)
+        #endif
+        search_tasks(&child, engine, pos, depth - 1, res);
+    }
+}
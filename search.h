@@ -0,0 +1,156 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "board.h"
+#include "valset.h"
+#include "lines.h"
+
+// The state of a depth first search on the flat board representation.
+// Besides the tiles it carries the running sum and the number of empty tiles of every line, which are updated on each placement.
+typedef struct {
+    const board_layout *layout;
+    int N_s, M;
+    int cells[HEX_MAX_CELLS];
+    int line_sum[HEX_MAX_LINES];
+    int line_free[HEX_MAX_LINES];
+    // The values placed on every line
+    valset_t line_values[HEX_MAX_LINES];
+    // The index of the valid lines which restricts the candidate values, NULL if only the bounds of the line sums are used
+    const line_index *index;
+    // Number of complete lines which don't sum up to M
+    int lines_wrong;
+    // The lines which have exactly one empty tile left
+    uint64_t lines_one_free;
+    // The values which haven't been placed yet
+    valset_t available;
+    // Smallest and largest sum the given number of other empty tiles of a line can add
+    int min_rest[HEX_MAX_ROWS + 1];
+    int max_rest[HEX_MAX_ROWS + 1];
+    // The order in which search_propagate branches on the empty tiles
+    unsigned char order[HEX_MAX_CELLS];
+    int order_length;
+    bool check_partial, find_all, print_solutions;
+    // Whether only the canonical representative of each set of symmetric boards is searched
+    bool symmetry;
+    // Whether search_engine uses the engines specialized for the size of the hexagon if there are any
+    bool specialized;
+    // Whether the recursive engines look up the remaining boards in the table of their thread, and the key of the remaining board
+    bool memo;
+    uint64_t key;
+    long long sol_cnt;
+    // Number of solutions including their rotations and reflections
+    long long sol_expanded;
+    // Number of tiles placed by the search
+    long long nodes;
+} search_state;
+
+// The results the tasks of search_tasks add up
+typedef struct {
+    long long sol_cnt, sol_expanded;
+    long long nodes;
+    // Seconds the tasks spent in the engines, added up over all threads
+    double seconds;
+    // Whether a task found a solution, which is stored in cells, while searching for the first one
+    bool found;
+    int cells[HEX_MAX_CELLS];
+} task_results;
+
+// Set once the search for the first solution should stop, because another thread or process found one
+extern bool search_stop;
+// Called regularly by the engines to learn about solutions found by other processes, NULL if there are none
+extern void (*search_poll)(void);
+// The engines call search_poll whenever the number of placed tiles is a multiple of this
+#define SEARCH_POLL_INTERVAL (1 << 14)
+// Tiles the thread placed since it last called search_poll, for the searches whose search states are too short-lived to reach the interval on their own
+extern long long poll_placed;
+#ifdef _OPENMP
+    #pragma omp threadprivate(poll_placed)
+#endif
+
+static inline bool search_stopped(void){
+    /* This function returns whether the search should stop. It is read by all threads without locking.
+    */
+    return __atomic_load_n(&search_stop, __ATOMIC_RELAXED);
+}
+
+static inline void set_search_stop(bool stop){
+    /* This function tells all threads whether the search should stop.
+    */
+    __atomic_store_n(&search_stop, stop, __ATOMIC_RELAXED);
+}
+
+// The search engines which can be selected on the command line
+#define ENGINE_ROW_MAJOR 0
+#define ENGINE_PROPAGATE 1
+#define ENGINE_ITERATIVE 2
+// Joins the upper and lower halves of the board instead of searching all tiles, see meet.c
+#define ENGINE_MEET 3
+
+// A level of search_iterative: the tile it branches on and the candidate values not tried yet.
+// The untried values of any frame are a subtree of their own, which could be handed to another worker.
+typedef struct {
+    unsigned char cell;
+    valset_t untried;
+} search_frame;
+
+// The explicit stack of search_iterative, frame depth - 1 is the deepest one
+typedef struct {
+    search_frame frames[HEX_MAX_CELLS];
+    int depth;
+} search_stack;
+
+static inline void poll_search(const search_state *s){
+    /* This function calls search_poll once every SEARCH_POLL_INTERVAL placed tiles.
+    */
+    if (search_poll != NULL && s->nodes % SEARCH_POLL_INTERVAL == 0)
+        search_poll();
+}
+
+static inline void poll_placements(long long cnt){
+    /* This function adds cnt placed tiles to the ones of the thread and calls search_poll once they reach SEARCH_POLL_INTERVAL.
+    */
+    if (search_poll == NULL)
+        return;
+    poll_placed += cnt;
+    if (poll_placed >= SEARCH_POLL_INTERVAL){
+        poll_placed = 0;
+        search_poll();
+    }
+}
+
+void init_search_state(search_state *s, const board_layout *layout, int N_s, int M, bool check_partial, bool find_all, bool print_solutions, bool symmetry);
+
+void enable_memo(search_state *s);
+
+void place_tile(search_state *s, int cell, int value);
+
+void remove_tile(search_state *s, int cell);
+
+valset_t candidate_values(const search_state *s, int cell);
+
+valset_t symmetry_values(const search_state *s, int cell);
+
+bool validate_symmetry(const search_state *s);
+
+valset_t tile_candidates(const search_state *s, int cell);
+
+bool search_depth_first(search_state *s);
+
+void plan_search_order(search_state *s);
+
+bool search_propagate(search_state *s, int pos);
+
+int next_tile(const search_state *s, int engine, int *pos);
+
+bool search_iterative(search_state *s, search_stack *stack);
+
+bool kernel_tables_match(const board_layout *layout);
+
+bool search_engine(search_state *s, int engine, int pos);
+
+void search_tasks(search_state *s, int engine, int pos, int depth, task_results *res);
+
+#endif
@@ -0,0 +1,79 @@
+/*Here you can find the search engines specialized for hexagons of side length KERNEL_N.
+This file is included by search.c once for every specialized size, with KERNEL_N defined before. The number of tiles and the line tables of search_tables.h are compile time constants in these kernels, so the compiler knows all loop bounds over the tiles and reads the lines of a tile at fixed addresses, and the line updates are always inlined instead of called.
+The kernels visit the tiles in the same order and try the same values as the generic engines, so they place the same number of tiles.
+*/
+
+#define KERNEL_CELLS (3*KERNEL_N*KERNEL_N-3*KERNEL_N+1)
+#define KERNEL_NAME(name) KERNEL_CONCAT(name, KERNEL_N)
+#define KERNEL_CONCAT(name, n) KERNEL_CONCAT_EXPANDED(name, n)
+#define KERNEL_CONCAT_EXPANDED(name, n) name##_n##n
+// The static line tables of search_tables.h for KERNEL_N
+#define KERNEL_TABLES ((line_tables){KERNEL_NAME(kernel_cell_lines), KERNEL_NAME(kernel_line_length), KERNEL_NAME(kernel_line_start), KERNEL_NAME(kernel_line_cells)})
+
+static bool KERNEL_NAME(search_depth_first)(search_state *s, int from){
+    /* This function implements search_depth_first for KERNEL_N, where all tiles before from are already set.
+    */
+    int i, k;
+    // Give up if the first solution was found elsewhere
+    if (search_stopped())
+        return false;
+    // Find the next empty tile
+    for (i = from; i < KERNEL_CELLS && s->cells[i] > 0; i++);
+    // To this point we only get if all tiles have a value assigned
+    if (i == KERNEL_CELLS)
+        return finish_board(s);
+    if (memo_hit(s))
+        return false;
+    long long found = s->sol_cnt;
+
+    valset_t candidates = tile_candidates_inline(s, KERNEL_TABLES, i);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        place_tile_inline(s, KERNEL_TABLES, i, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+        if (KERNEL_NAME(search_depth_first)(s, i + 1)){
+            return true;
+        }
+        remove_tile_inline(s, KERNEL_TABLES, i);
+    }
+    memo_finish(s, found);
+    return false;
+}
+
+static bool KERNEL_NAME(search_propagate)(search_state *s, int pos){
+    /* This function implements search_propagate for KERNEL_N.
+    */
+    int k;
+    // Give up if the first solution was found elsewhere
+    if (search_stopped())
+        return false;
+    int cell = propagate_next_tile(s, KERNEL_TABLES, &pos);
+    if (cell < 0)
+        return finish_board(s);
+    if (memo_hit(s))
+        return false;
+    long long found = s->sol_cnt;
+
+    valset_t candidates = tile_candidates_inline(s, KERNEL_TABLES, cell);
+    while (candidates){
+        k = valset_first(candidates);
+        candidates &= candidates - 1;
+        place_tile_inline(s, KERNEL_TABLES, cell, k + s->N_s);
+        s->nodes++;
+        poll_search(s);
+        if (KERNEL_NAME(search_propagate)(s, pos)){
+            return true;
+        }
+        remove_tile_inline(s, KERNEL_TABLES, cell);
+    }
+    memo_finish(s, found);
+    return false;
+}
+
+#undef KERNEL_CELLS
+#undef KERNEL_TABLES
+#undef KERNEL_NAME
+#undef KERNEL_CONCAT
+#undef KERNEL_CONCAT_EXPANDED
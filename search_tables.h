@@ -0,0 +1,110 @@
+/*Here you can find the line tables of the hexagons the specialized kernels of search_kernel.h are compiled for.
+They hold the same values init_board_layout computes for these sizes: the line of each diagonal a tile is in, and the length, offset and tiles of every line.
+Being static constants, the kernels read them at fixed addresses instead of through the layout of the search state.
+*/
+
+#ifndef SEARCH_TABLES_H
+#define SEARCH_TABLES_H
+
+// Side length 2: 7 tiles and 9 lines
+static const unsigned char kernel_cell_lines_n2[7][3] = {
+    {0, 4, 8}, {0, 5, 7}, {1, 3, 8}, {1, 4, 7}, {1, 5, 6}, {2, 3, 7},
+    {2, 4, 6}
+};
+static const unsigned char kernel_line_length_n2[9] = {
+    2, 3, 2, 2, 3, 2, 2, 3, 2
+};
+static const unsigned short kernel_line_start_n2[9] = {
+    0, 2, 5, 7, 9, 12, 14, 16, 19
+};
+static const unsigned char kernel_line_cells_n2[21] = {
+    0, 1, 2, 3, 4, 5, 6, 2, 5, 0, 3, 6, 1, 4, 4, 6,
+    1, 3, 5, 0, 2
+};
+
+// Side length 3: 19 tiles and 15 lines
+static const unsigned char kernel_cell_lines_n3[19][3] = {
+    {0, 7, 14}, {0, 8, 13}, {0, 9, 12}, {1, 6, 14}, {1, 7, 13}, {1, 8, 12},
+    {1, 9, 11}, {2, 5, 14}, {2, 6, 13}, {2, 7, 12}, {2, 8, 11}, {2, 9, 10},
+    {3, 5, 13}, {3, 6, 12}, {3, 7, 11}, {3, 8, 10}, {4, 5, 12}, {4, 6, 11},
+    {4, 7, 10}
+};
+static const unsigned char kernel_line_length_n3[15] = {
+    3, 4, 5, 4, 3, 3, 4, 5, 4, 3, 3, 4, 5, 4, 3
+};
+static const unsigned short kernel_line_start_n3[15] = {
+    0, 3, 7, 12, 16, 19, 22, 26, 31, 35, 38, 41, 45, 50, 54
+};
+static const unsigned char kernel_line_cells_n3[57] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 7, 12, 16, 3, 8, 13, 17, 0, 4, 9, 14, 18, 1,
+    5, 10, 15, 2, 6, 11, 11, 15, 18, 6, 10, 14, 17, 2, 5, 9,
+    13, 16, 1, 4, 8, 12, 0, 3, 7
+};
+
+// Side length 4: 37 tiles and 21 lines
+static const unsigned char kernel_cell_lines_n4[37][3] = {
+    {0, 10, 20}, {0, 11, 19}, {0, 12, 18}, {0, 13, 17}, {1, 9, 20}, {1, 10, 19},
+    {1, 11, 18}, {1, 12, 17}, {1, 13, 16}, {2, 8, 20}, {2, 9, 19}, {2, 10, 18},
+    {2, 11, 17}, {2, 12, 16}, {2, 13, 15}, {3, 7, 20}, {3, 8, 19}, {3, 9, 18},
+    {3, 10, 17}, {3, 11, 16}, {3, 12, 15}, {3, 13, 14}, {4, 7, 19}, {4, 8, 18},
+    {4, 9, 17}, {4, 10, 16}, {4, 11, 15}, {4, 12, 14}, {5, 7, 18}, {5, 8, 17},
+    {5, 9, 16}, {5, 10, 15}, {5, 11, 14}, {6, 7, 17}, {6, 8, 16}, {6, 9, 15},
+    {6, 10, 14}
+};
+static const unsigned char kernel_line_length_n4[21] = {
+    4, 5, 6, 7, 6, 5, 4, 4, 5, 6, 7, 6, 5, 4, 4, 5,
+    6, 7, 6, 5, 4
+};
+static const unsigned short kernel_line_start_n4[21] = {
+    0, 4, 9, 15, 22, 28, 33, 37, 41, 46, 52, 59, 65, 70, 74, 78,
+    83, 89, 96, 102, 107
+};
+static const unsigned char kernel_line_cells_n4[111] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 15, 22, 28, 33, 9, 16, 23, 29, 34, 4, 10,
+    17, 24, 30, 35, 0, 5, 11, 18, 25, 31, 36, 1, 6, 12, 19, 26,
+    32, 2, 7, 13, 20, 27, 3, 8, 14, 21, 21, 27, 32, 36, 14, 20,
+    26, 31, 35, 8, 13, 19, 25, 30, 34, 3, 7, 12, 18, 24, 29, 33,
+    2, 6, 11, 17, 23, 28, 1, 5, 10, 16, 22, 0, 4, 9, 15
+};
+
+// Side length 5: 61 tiles and 27 lines
+static const unsigned char kernel_cell_lines_n5[61][3] = {
+    {0, 13, 26}, {0, 14, 25}, {0, 15, 24}, {0, 16, 23}, {0, 17, 22}, {1, 12, 26},
+    {1, 13, 25}, {1, 14, 24}, {1, 15, 23}, {1, 16, 22}, {1, 17, 21}, {2, 11, 26},
+    {2, 12, 25}, {2, 13, 24}, {2, 14, 23}, {2, 15, 22}, {2, 16, 21}, {2, 17, 20},
+    {3, 10, 26}, {3, 11, 25}, {3, 12, 24}, {3, 13, 23}, {3, 14, 22}, {3, 15, 21},
+    {3, 16, 20}, {3, 17, 19}, {4, 9, 26}, {4, 10, 25}, {4, 11, 24}, {4, 12, 23},
+    {4, 13, 22}, {4, 14, 21}, {4, 15, 20}, {4, 16, 19}, {4, 17, 18}, {5, 9, 25},
+    {5, 10, 24}, {5, 11, 23}, {5, 12, 22}, {5, 13, 21}, {5, 14, 20}, {5, 15, 19},
+    {5, 16, 18}, {6, 9, 24}, {6, 10, 23}, {6, 11, 22}, {6, 12, 21}, {6, 13, 20},
+    {6, 14, 19}, {6, 15, 18}, {7, 9, 23}, {7, 10, 22}, {7, 11, 21}, {7, 12, 20},
+    {7, 13, 19}, {7, 14, 18}, {8, 9, 22}, {8, 10, 21}, {8, 11, 20}, {8, 12, 19},
+    {8, 13, 18}
+};
+static const unsigned char kernel_line_length_n5[27] = {
+    5, 6, 7, 8, 9, 8, 7, 6, 5, 5, 6, 7, 8, 9, 8, 7,
+    6, 5, 5, 6, 7, 8, 9, 8, 7, 6, 5
+};
+static const unsigned short kernel_line_start_n5[27] = {
+    0, 5, 11, 18, 26, 35, 43, 50, 56, 61, 66, 72, 79, 87, 96, 104,
+    111, 117, 122, 127, 133, 140, 148, 157, 165, 172, 178
+};
+static const unsigned char kernel_line_cells_n5[183] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 26, 35, 43,
+    50, 56, 18, 27, 36, 44, 51, 57, 11, 19, 28, 37, 45, 52, 58, 5,
+    12, 20, 29, 38, 46, 53, 59, 0, 6, 13, 21, 30, 39, 47, 54, 60,
+    1, 7, 14, 22, 31, 40, 48, 55, 2, 8, 15, 23, 32, 41, 49, 3,
+    9, 16, 24, 33, 42, 4, 10, 17, 25, 34, 34, 42, 49, 55, 60, 25,
+    33, 41, 48, 54, 59, 17, 24, 32, 40, 47, 53, 58, 10, 16, 23, 31,
+    39, 46, 52, 57, 4, 9, 15, 22, 30, 38, 45, 51, 56, 3, 8, 14,
+    21, 29, 37, 44, 50, 2, 7, 13, 20, 28, 36, 43, 1, 6, 12, 19,
+    27, 35, 0, 5, 11, 18, 26
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*Here you can find the memory shared by the processes of a node, which keeps large read-only structures once per node instead of once per process.
+The processes which can share memory are found with MPI_Comm_split_type. The first process of a node allocates a window with MPI_Win_allocate_shared and fills it, and all other processes of the node read it in place through the address MPI_Win_shared_query gives them.
+The first process writes the window within a passive epoch, which every process syncs before and after a barrier, so the others see the complete structure once publish_node_window returns.
+Every process maps the window at its own address, so a structure in a window holds no pointers into it, but the counts from which every process finds its parts.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi.h>
+
+#include "shared.h"
+
+MPI_Comm node_comm = MPI_COMM_NULL;
+
+void init_node_comm(void){
+    /* This function groups the processes by the node they run on.
+    */
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, my_rank, MPI_INFO_NULL, &node_comm);
+}
+
+void free_node_comm(void){
+    if (node_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&node_comm);
+}
+
+int node_rank(void){
+    /* This function returns the rank of this process among the processes of its node.
+    */
+    int rank;
+    MPI_Comm_rank(node_comm, &rank);
+    return rank;
+}
+
+int count_node_groups(void){
+    /* This function returns the number of nodes the processes run on, which is the number of processes which are the first one of their node.
+    */
+    int first = node_rank() == 0, nodes;
+    MPI_Allreduce(&first, &nodes, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    return nodes;
+}
+
+void *open_node_window(size_t size, node_window *window){
+    /* This function allocates a window of the size given by the first process of the node on it and returns its address in this process.
+    Only the first process of the node writes the window, until it calls publish_node_window. All processes of the node have to call this function together.
+    */
+    unsigned long long bytes = size;
+    MPI_Aint actual;
+    int disp_unit;
+    MPI_Bcast(&bytes, 1, MPI_UNSIGNED_LONG_LONG, 0, node_comm);
+    window->size = bytes;
+    // A window can't be empty on every process, so the first process allocates at least one byte
+    if (MPI_Win_allocate_shared(node_rank() == 0 ? (MPI_Aint)(bytes > 0 ? bytes : 1) : 0, 1, MPI_INFO_NULL, node_comm, &window->base, &window->win) != MPI_SUCCESS){
+        printf("Could not allocate %llu bytes of shared memory!\n", bytes);
+        exit(-1);
+    }
+    MPI_Win_shared_query(window->win, 0, &actual, &disp_unit, &window->base);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window->win);
+    return window->base;
+}
+
+void publish_node_window(node_window *window){
+    /* This function makes what the first process wrote to the window visible to all processes of the node, which only read it from now on.
+    */
+    MPI_Win_sync(window->win);
+    MPI_Barrier(node_comm);
+    MPI_Win_sync(window->win);
+}
+
+void close_node_window(node_window *window){
+    /* This function releases the window once no process of the node reads it anymore. All processes of the node have to call this function together.
+    */
+    MPI_Win_unlock_all(window->win);
+    MPI_Win_free(&window->win);
+    window->base = NULL;
+    window->size = 0;
+}
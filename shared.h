@@ -0,0 +1,32 @@
+#ifndef SHARED_H
+#define SHARED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <mpi.h>
+
+// Memory of the first process of a node which all processes of the node read in place
+typedef struct {
+    MPI_Win win;
+    void *base;
+    size_t size;
+} node_window;
+
+// The processes on the same node as this one, ordered by their rank
+extern MPI_Comm node_comm;
+
+void init_node_comm(void);
+
+void free_node_comm(void);
+
+int node_rank(void);
+
+int count_node_groups(void);
+
+void *open_node_window(size_t size, node_window *window);
+
+void publish_node_window(node_window *window);
+
+void close_node_window(node_window *window);
+
+#endif
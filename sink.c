@@ -0,0 +1,196 @@
+/*Here you can find the output of the found solutions, which keeps writing them off the critical path of the search.
+Every solution is a record of one line, holding the values of the tiles in row-major order of the first diagonal.
+Each thread appends its records to its own buffer and only takes the lock to write the buffer once it is full, so threads don't wait for each other on every solution.
+In parallel, every process writes to its own file, so the records of different processes never interleave.
+Optionally, the records of all processes can be reduced to one record per set of rotated and reflected solutions afterwards.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#include "sink.h"
+
+// The file the records are written to, whether it has to be closed, and the buffers of the threads
+static FILE *sink_file = NULL;
+static bool sink_owns_file = false;
+static char *sink_buffers = NULL;
+static int *sink_used = NULL;
+static int sink_threads = 0;
+// Number of records written to the sink
+static long long sink_records = 0;
+// Number of values of the records which are sorted
+static int record_length = 0;
+
+static void sink_file_name(char *name, size_t size, const char *path, int rank, int ranks){
+    /* This function returns the file a process writes its records to, which is the path itself unless executed on several processes.
+    */
+    if (ranks > 1)
+        snprintf(name, size, "%s.%d", path, rank);
+    else
+        snprintf(name, size, "%s", path);
+}
+
+void open_solution_sink(const char *path, int rank, int ranks){
+    /* This function opens the sink of the solutions of this process, which writes to the console if no path is given.
+    */
+    int threads = 1;
+    #ifdef _OPENMP
+        threads = omp_get_max_threads();
+    #endif
+    if (path != NULL){
+        char name[strlen(path) + 16];
+        sink_file_name(name, sizeof(name), path, rank, ranks);
+        sink_file = fopen(name, "w");
+        if (sink_file == NULL){
+            printf("Could not open %s to write the solutions!\n", name);
+            exit(-1);
+        }
+        sink_owns_file = true;
+    }
+    else{
+        sink_file = stdout;
+        sink_owns_file = false;
+    }
+    sink_buffers = malloc((size_t)threads * SINK_BUFFER_SIZE);
+    sink_used = calloc(threads, sizeof(int));
+    if (sink_buffers == NULL || sink_used == NULL){
+        printf("Could not allocate the buffers of the solutions!\n");
+        exit(-1);
+    }
+    sink_threads = threads;
+    sink_records = 0;
+}
+
+static void flush_buffer(int thread){
+    /* This function writes the buffer of a thread to the file. The file is shared, so only one thread writes at a time.
+    */
+    #ifdef _OPENMP
+        #pragma omp critical(solution_sink)
+    #endif
+    {
+        fwrite(sink_buffers + (size_t)thread * SINK_BUFFER_SIZE, 1, sink_used[thread], sink_file);
+    }
+    sink_used[thread] = 0;
+}
+
+void sink_solution(const int *values, int cnt){
+    /* This function appends the record of a solution with cnt values to the buffer of the calling thread and writes the buffer if it is full.
+    */
+    int thread = 0, k, length = 0;
+    #ifdef _OPENMP
+        thread = omp_get_thread_num();
+    #endif
+    // Every value takes at most 11 characters with its separator
+    char record[cnt * 12 + 2];
+    for (k = 0; k < cnt; k++){
+        length += sprintf(record + length, k < cnt - 1 ? "%d " : "%d\n", values[k]);
+    }
+    if (sink_used[thread] + length > SINK_BUFFER_SIZE)
+        flush_buffer(thread);
+    memcpy(sink_buffers + (size_t)thread * SINK_BUFFER_SIZE + sink_used[thread], record, length);
+    sink_used[thread] += length;
+    #ifdef _OPENMP
+        #pragma omp atomic
+    #endif
+    sink_records++;
+}
+
+long long close_solution_sink(void){
+    /* This function writes the records left in the buffers and closes the sink. It returns the number of records written.
+    */
+    int k;
+    if (sink_file == NULL)
+        return 0;
+    for (k = 0; k < sink_threads; k++){
+        flush_buffer(k);
+    }
+    if (sink_owns_file)
+        fclose(sink_file);
+    else
+        fflush(sink_file);
+    free(sink_buffers);
+    free(sink_used);
+    sink_file = NULL;
+    sink_buffers = NULL;
+    sink_used = NULL;
+    return sink_records;
+}
+
+static int compare_records(const void *a, const void *b){
+    /* This function orders two records of record_length values lexicographically.
+    */
+    const int *x = a, *y = b;
+    int k;
+    for (k = 0; k < record_length; k++){
+        if (x[k] != y[k])
+            return x[k] < y[k] ? -1 : 1;
+    }
+    return 0;
+}
+
+long long deduplicate_solutions(const char *path, int ranks, const board_layout *layout){
+    /* This function reads the records of all processes, replaces every solution by the smallest of its rotations and reflections and writes each of these once to path, in ascending order.
+    It returns the number of distinct solutions, or -1 if a file could not be read or written.
+    */
+    int N = layout->N;
+    int rank, k;
+    long long cnt = 0, capacity = 1024, distinct = 0, i;
+    int *records = malloc(capacity * N * sizeof(int));
+    int values[N];
+    char name[strlen(path) + 16];
+
+    for (rank = 0; rank < ranks; rank++){
+        sink_file_name(name, sizeof(name), path, rank, ranks);
+        FILE *file = fopen(name, "r");
+        if (file == NULL){
+            printf("Could not read the solutions in %s!\n", name);
+            free(records);
+            return -1;
+        }
+        bool complete = true;
+        while (complete){
+            for (k = 0; k < N && complete; k++){
+                complete = fscanf(file, "%d", &values[k]) == 1;
+            }
+            if (!complete)
+                break;
+            if (cnt == capacity){
+                capacity *= 2;
+                records = realloc(records, capacity * N * sizeof(int));
+                if (records == NULL){
+                    printf("Could not allocate memory for %lld solutions!\n", capacity);
+                    exit(-1);
+                }
+            }
+            canonical_board(layout, values, records + cnt * N);
+            cnt++;
+        }
+        fclose(file);
+    }
+
+    // Equal canonical boards are next to each other once sorted
+    record_length = N;
+    qsort(records, cnt, N * sizeof(int), compare_records);
+    FILE *file = fopen(path, "w");
+    if (file == NULL){
+        printf("Could not write the solutions to %s!\n", path);
+        free(records);
+        return -1;
+    }
+    for (i = 0; i < cnt; i++){
+        if (i > 0 && memcmp(records + i * N, records + (i - 1) * N, N * sizeof(int)) == 0)
+            continue;
+        for (k = 0; k < N; k++){
+            fprintf(file, k < N - 1 ? "%d " : "%d\n", records[i * N + k]);
+        }
+        distinct++;
+    }
+    fclose(file);
+    free(records);
+    return distinct;
+}
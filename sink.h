@@ -0,0 +1,19 @@
+#ifndef SINK_H
+#define SINK_H
+
+#include <stdbool.h>
+
+#include "board.h"
+
+// Size in bytes of the buffer of every thread, which is written once it is full
+#define SINK_BUFFER_SIZE (1 << 16)
+
+void open_solution_sink(const char *path, int rank, int ranks);
+
+void sink_solution(const int *values, int cnt);
+
+long long close_solution_sink(void);
+
+long long deduplicate_solutions(const char *path, int ranks, const board_layout *layout);
+
+#endif
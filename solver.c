@@ -11,8 +11,10 @@ https://www.redblobgames.com/grids/hexagons/
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <sched.h>
 #include <mpi.h>
 #ifdef _OPENMP
@@ -20,12 +22,95 @@ https://www.redblobgames.com/grids/hexagons/
 #endif
 
 #include "helpers.h"
+#include "board.h"
+#include "search.h"
+#include "schedule.h"
+#include "prefix.h"
+#include "checkpoint.h"
+#include "results.h"
+#include "stats.h"
+#include "sink.h"
+#include "lines.h"
+#include "meet.h"
+#include "memo.h"
+#include "estimate.h"
+#include "shared.h"
 
-bool solver_depth_first(int r, int n, int N, int N_s, int M, int (*board)[r][r], bool *value_used, bool check_partial, bool find_all, bool print_solutions, int *sol_cnt){
+// The configuration of the solver selected on the command line
+typedef struct {
+    int n, r, N_s, N, M;
+    bool find_all;
+    int precomputed_row, nr_s;
+    bool parallel_exec, check_partial, print_solutions;
+    int verbosity, benchmark;
+    bool flat_layout;
+    int engine;
+    bool symmetry;
+    // Whether the engines specialized for the size of the hexagon are used
+    bool specialized;
+    // Whether the work units are handed out on request instead of in equal blocks and how many at once
+    bool dynamic;
+    int chunk_size;
+    // Number of levels below a work unit which are split into OpenMP tasks, -1 to distribute whole work units in a parallel loop
+    int task_depth;
+    // Number of levels of the search frontier used as work units and the number of boards at which its expansion stops, 0 for no limit
+    int frontier_depth, frontier_target;
+    // The file the progress is written to every checkpoint_interval seconds, NULL if none, and whether to resume from it
+    const char *checkpoint_path;
+    int checkpoint_interval;
+    bool resume;
+    // The file the results of every work unit are written to as CSV, NULL if they aren't collected
+    const char *unit_stats_path;
+    // Whether the index of the valid lines is used and the index built for M, NULL if there is none
+    bool use_index;
+    const line_index *index;
+    // Bytes the meet-in-the-middle solver may keep in memory and the directory it writes to beyond that, NULL for the temporary directory
+    size_t meet_memory;
+    const char *spill_dir;
+    // Whether the recursive engines look up the remaining boards in the table of their thread
+    bool memo;
+    // Number of random probes which estimate the cost of every work unit before the work units are packed, 0 to distribute them in the order they are generated
+    int estimate_probes;
+} solver_config;
+
+// Value of the precomputed row which selects the boards of the search frontier as work units
+#define FRONTIER_ROW -2
+
+// Values getopt_long returns for the options which only have a long name
+#define OPT_CHECKPOINT 256
+#define OPT_CHECKPOINT_INTERVAL 257
+#define OPT_RESUME 258
+#define OPT_UNIT_STATS 259
+#define OPT_SOLUTIONS 260
+#define OPT_DEDUP 261
+#define OPT_MEET_MEMORY 262
+#define OPT_SPILL_DIR 263
+#define OPT_ESTIMATE 264
+
+// Statistics of a solver run which are reported besides the number of found solutions
+typedef struct {
+    // Number of tiles placed by the flat search engines
+    long long nodes;
+    // Number of found solutions including their rotations and reflections
+    long long sol_expanded;
+    // Time spent solving work units
+    double busy;
+} solver_stats;
+
+// The first solution found by this process while searching for the first one, in the selected board representation
+typedef struct {
+    bool found;
+    int *values;
+} first_solution;
+
+bool solver_depth_first(int r, int n, int N, int N_s, int M, int (*board)[r][r], bool *value_used, bool check_partial, bool find_all, bool print_solutions, long long *sol_cnt){
     /* This function implements the depth first search algorithm to solve the magic hexagon problem.
     The algorithm is used for both the serial and the parallel implementation. It recursively tries to set a value at an unset position and then checks if the board is still valid.
     */
     int i, j, k, row_length;
+    // Give up if the first solution was found elsewhere
+    if (search_stopped())
+        return false;
     // Loop over each row
     for (i = 0; i < r; i++){
         row_length = r-abs(n-1-i);
@@ -39,20 +124,23 @@ bool solver_depth_first(int r, int n, int N, int N_s, int M, int (*board)[r][r],
                 continue;
             }
             // It is not set, hence we can select a new value to set at that position and recurse
+            // If we selected to check partial solutions, all values which keep the board valid are found at once
+            bool viable[N];
+            if (check_partial)
+                viable_tile_values(r, board, M, n, N, N_s, a[j], value_used, viable);
+            #ifdef HEX_STATS
+                count_tile_stats(r, board, M, n, N, N_s, a[j], value_used, check_partial ? viable : NULL);
+            #endif
             for (k = 0; k < N; k++){
-                // find a value which hasn't been set yet
-                if (value_used[k])
+                // find a value which hasn't been set yet and keeps the board valid if we check partial solutions
+                if (check_partial ? !viable[k] : value_used[k])
                     continue;
                 // set it and recurse
                 board[a[j][0]][a[j][1]][a[j][2]] = k + N_s;
                 value_used[k] = true;
-                // If we selected to check partial solutions, we are now checking if the tile placement keeps the board valid
-                // If so we recurse
-                if (check_partial && validate_tile(r, board, M, n, a[j]) && solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, sol_cnt)){
-                    return true;
-                }
-                // If no partial check selected, we just recurse and return true if it works out
-                else if (!check_partial && solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, sol_cnt)){
+                // Check for the first solution of other processes as regularly as the flat engines do
+                poll_placements(1);
+                if (solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, sol_cnt)){
                     return true;
                 }
                 // else reset the tile and try the next available value
@@ -68,10 +156,16 @@ bool solver_depth_first(int r, int n, int N, int N_s, int M, int (*board)[r][r],
 
     // To this point we only get if all tiles have a value assigned
     // Evaluate the board and return the result or print the board if we try to find all solutions
+    #ifdef HEX_STATS
+        thread_stats.leaves++;
+    #endif
     bool ret = validate_board(r, board, M, n);
     if (find_all && ret){
-        if (print_solutions)
-            print_board(r, n, board);
+        if (print_solutions){
+            int values[N];
+            board_values(r, n, board, values);
+            sink_solution(values, N);
+        }
         (*sol_cnt)++;
         return false;
     }
@@ -80,67 +174,668 @@ bool solver_depth_first(int r, int n, int N, int N_s, int M, int (*board)[r][r],
     }
 }
 
-bool generate_starting_row(int row_length, int N, int N_s, int M, int nr_s, int (*starting_row_list), int *prev_nrs, int ind, int *cnt){
-    /* This function generates all possible starting rows for the solver. It is used to parallelize the solver. The geneartion is done by looking at all possible combinations of distinct numbers for the selected row that add up to M.
+bool prepare_search(const solver_config *cfg, const board_layout *layout, const int *vals_to_solve, search_state *state){
+    /* This function places the values to solve on an empty search state, which initializes the running line sums.
+    It returns false if the values are not canonical, as they then belong to a symmetric board of other precomputed values.
+    */
+    int i;
+    init_search_state(state, layout, cfg->N_s, cfg->M, cfg->check_partial, cfg->find_all, cfg->print_solutions, cfg->symmetry);
+    for (i = 0; i < cfg->N; i++){
+        if (vals_to_solve[i] > 0)
+            place_tile(state, i, vals_to_solve[i]);
+    }
+    state->specialized = cfg->specialized;
+    state->index = cfg->index;
+    if (cfg->memo)
+        enable_memo(state);
+    if (!validate_symmetry(state))
+        return false;
+    if (cfg->engine == ENGINE_PROPAGATE)
+        plan_search_order(state);
+    return true;
+}
+
+bool solve_board(const solver_config *cfg, const board_layout *layout, int *vals_to_solve, int *cells, int (*board)[cfg->r][cfg->r], bool *value_used, long long *sol_cnt, long long *sol_expanded, long long *nodes){
+    /* This function places the values to solve on the selected board representation and calls the selected search engine.
+    If no layout is given, the r x r x r cube representation is used.
+    */
+    if (layout != NULL){
+        search_state state;
+        if (!prepare_search(cfg, layout, vals_to_solve, &state))
+            return false;
+        bool ret = search_engine(&state, cfg->engine, 0);
+        *sol_cnt += state.sol_cnt;
+        *sol_expanded += state.sol_expanded;
+        *nodes += state.nodes;
+        memcpy(cells, state.cells, cfg->N * sizeof(int));
+        return ret;
+    }
+    fill_board(vals_to_solve, cfg->r, cfg->n, board);
+    long long found = *sol_cnt;
+    bool ret = solver_depth_first(cfg->r, cfg->n, cfg->N, cfg->N_s, cfg->M, board, value_used, cfg->check_partial, cfg->find_all, cfg->print_solutions, sol_cnt);
+    *sol_expanded += *sol_cnt - found;
+    return ret;
+}
+
+void print_solution(int r, int n, const board_layout *layout, const int *cells, int (*board)[r][r]){
+    /* This function prints out the board of the selected board representation.
+    */
+    if (layout != NULL)
+        print_flat_board(layout, cells);
+    else
+        print_board(r, n, board);
+}
+
+void record_solution(first_solution *first, int size, const int *values){
+    /* This function stores the first solution a thread of this process found and tells all threads to stop.
+    If the other processes are polled, they are told right away as well.
+    */
+    #ifdef _OPENMP
+        #pragma omp critical(first_solution)
+    #endif
+    {
+        if (!first->found){
+            memcpy(first->values, values, size * sizeof(int));
+            first->found = true;
+        }
+    }
+    set_search_stop(true);
+    if (search_poll != NULL)
+        search_poll();
+}
+
+void solve_rows(const solver_config *cfg, const board_layout *layout, const int *rows, int row_length, int start_index, int first, int last, int my_rank, long long *sol_cnt, long long *sol_expanded, long long *node_cnt, first_solution *solution, unit_table *table){
+    /* This function solves the boards given by the precomputed rows first to last - 1, each of which is set on the tiles starting at start_index.
+    If OpenMP is available, the rows are distributed among the threads. If we only want to find the first solution, it is stored in solution once found and the remaining rows are skipped.
+    If a table is given, the results of every solved row are added to it.
     */
+    int r = cfg->r, N = cfg->N, N_s = cfg->N_s;
+    int verbosity = cfg->verbosity;
+    bool find_all = cfg->find_all;
+
+    // This is the board to solve
+    int board[r][r][r];
+    // This is the board to solve if the flat representation is used
+    int cells[N];
+    // This array holds the values which we will initially set on the board
+    int vals_to_solve[N];
+    // A list which determines whether a value has already been set
+    bool value_used[N];
     int i, j;
-    bool duplicated = false;
-    int start_index = 0;
-
-    // Run over each position in the starting row
-    if (ind < row_length){
-        // Loop over all possible numbers
-        for (i = start_index; i < N; i++){
-            // Check if the number has already been used
-            duplicated = false;
-            for (j = 0; j < ind; j++){
-                if (prev_nrs[j] == i){
-                    duplicated = true;
+    for (i = 0; i < N; i++){
+        vals_to_solve[i] = 0;
+    }
+
+    int visited = 0;
+    bool ret_solver;
+    long long found = 0, expanded = 0;
+    long long nodes = 0;
+
+    // With task parallelism every precomputed combination becomes a task with its own search state, which spawns further tasks for the first levels below it
+    if (layout != NULL && cfg->task_depth >= 0){
+        // The tasks of each row add up their results separately, so they can be told apart afterwards
+        task_results *res = calloc(last > first ? last - first : 1, sizeof(task_results));
+        // Rows which are skipped once the first solution was found don't have results
+        bool started[last > first ? last - first : 1];
+        for (i = first; i < last; i++){
+            started[i - first] = false;
+        }
+        #ifdef _OPENMP
+            #pragma omp parallel default(none) private(i, j) firstprivate(vals_to_solve) shared(first, last, row_length, rows, start_index, cfg, layout, res, started)
+            #pragma omp single
+        #endif
+        {
+            for (i = first; i < last; i++){
+                // No more tasks are needed once the first solution was found
+                if (search_stopped())
                     break;
+                started[i - first] = true;
+                for (j = 0; j < row_length; j++){
+                    vals_to_solve[start_index + j] = rows[i * row_length + j];
                 }
+                search_state state;
+                if (!prepare_search(cfg, layout, vals_to_solve, &state))
+                    continue;
+                #ifdef _OPENMP
+                    #pragma omp task firstprivate(state, i) shared(cfg, res)
+                #endif
+                search_tasks(&state, cfg->engine, 0, cfg->task_depth, &res[i - first]);
             }
-            if (duplicated)
-                continue;
-            // Set this number as new one and recurse until all numbers in the row are set
-            prev_nrs[ind] = i;
-            if (ind < row_length-1){
-                if (!generate_starting_row(row_length, N, N_s, M, nr_s, starting_row_list, prev_nrs, ind + 1, cnt)){
-                    return false;
-                }
+        }
+        for (i = first; i < last; i++){
+            task_results *unit = &res[i - first];
+            *sol_cnt += unit->sol_cnt;
+            *sol_expanded += unit->sol_expanded;
+            *node_cnt += unit->nodes;
+            // The time of a row is the time its tasks spent searching on all threads
+            if (table != NULL && started[i - first])
+                add_unit_result(table, rows + (size_t)i * row_length, my_rank, unit->sol_cnt, unit->nodes, unit->seconds);
+            // If we only want to find the first solution, we can stop if we found one
+            if (!find_all && unit->found){
+                record_solution(solution, N, unit->cells);
             }
-            // If all numbers are set, check if the row is valid, meaning if it sums up to M
-            else{
-                int sum = 0;
-                int k;
-                for (k = 0; k < row_length; k++){
-                    sum += prev_nrs[k] + N_s;
-                }
-                // If not valid, try the next number
-                if (sum != M){
-                    continue;
+        }
+        free(res);
+        return;
+    }
+
+    // Only use OpenMP if we can access the API. If so, parallelize the loop over the precomputed combinations
+    // A thread takes the next combination once it is done, so packed work units are solved from the most expensive one on
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) default(none) private(j, value_used, board, cells, ret_solver) firstprivate(vals_to_solve, visited) shared(N, first, last, r, row_length, N_s, rows, my_rank, verbosity, find_all, start_index, cfg, layout, solution, table) reduction(+:found, expanded, nodes)
+    #endif
+    // Loop over the assigned precomputed combinations of this process
+    for (i = first; i < last; i++){
+        // Skip the remaining combinations once the first solution was found
+        if (search_stopped())
+            continue;
+        // Print out the process and the CPU it is running on as well as the thread if OpenMP is used
+        if (verbosity > 1 && visited == 0){
+            #ifdef _OPENMP
+                #pragma omp critical
+                {
+                    printf("Thread %d of process %d on CPU %d\n", omp_get_thread_num(), my_rank, sched_getcpu());
+                    if (verbosity > 2)
+                        print_solution(r, cfg->n, layout, cells, board);
                 }
-                // If valid, add it to the list of starting rows
-                for (k = 0; k < row_length; k++){
-                    starting_row_list[(*cnt) * row_length + k] = prev_nrs[k] + N_s;
+            #else
+                printf("Process %d on CPU %d\n", my_rank, sched_getcpu());
+            #endif
+            visited = 1;
+        }
+
+        // Fill the board with the values of the precomputed combination
+        fill_value_list(N, value_used);
+        for (j = 0; j < row_length; j++){
+            vals_to_solve[start_index + j] = rows[i * row_length + j];
+            if (rows[i * row_length + j] > 0)
+                value_used[rows[i * row_length + j] - N_s] = true;
+        }
+
+        // Call the solver
+        long long unit_found = found, unit_nodes = nodes;
+        struct timespec unit_start, unit_end;
+        clock_gettime(CLOCK_MONOTONIC, &unit_start);
+        ret_solver = solve_board(cfg, layout, vals_to_solve, cells, board, value_used, &found, &expanded, &nodes);
+        clock_gettime(CLOCK_MONOTONIC, &unit_end);
+        if (table != NULL){
+            #ifdef _OPENMP
+                #pragma omp critical(unit_table)
+            #endif
+            add_unit_result(table, rows + (size_t)i * row_length, my_rank, found - unit_found, nodes - unit_nodes, get_time_diff(unit_start, unit_end));
+        }
+
+        // If we only want to find the first solution, we can stop if we found one
+        if (!find_all){
+            if (ret_solver){
+                record_solution(solution, layout != NULL ? N : r * r * r, layout != NULL ? cells : &board[0][0][0]);
+            }
+        }
+    }
+    *sol_cnt += found;
+    *sol_expanded += expanded;
+    *node_cnt += nodes;
+}
+
+void solve_distributed(const solver_config *cfg, const board_layout *layout, unit_stream *stream, int start_index, long long *sol_cnt, long long *sol_expanded, long long *node_cnt, double *busy, first_solution *solution, checkpoint *cp, unit_table *table){
+    /* This function solves the work units of the stream opened by open_work_units on all processes.
+    With the static distribution each process solves its own share of the work units in batches of nr_s. With the dynamic distribution the first process produces the work units and hands out chunks of them to the other processes on request.
+    If we only want to find the first solution, a process which finds one tells all other processes to stop. The time spent solving is added to busy.
+    The first process keeps the checkpoint of the dynamic distribution in cp. If a table is given, every process adds the results of the work units it solved to it.
+    */
+    // Get the number of processes
+    int comm_sz;
+    MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+
+    // Get the rank of the process
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    double start;
+    int row_length = stream->row_length;
+    // The work units which are solved next
+    row_buffer batch;
+    init_row_buffer(&batch, row_length);
+
+    if (cfg->dynamic && comm_sz > 1){
+        if (my_rank == 0){
+            // Produce up to nr_s work units ahead of the requests
+            int queue_size = cfg->nr_s / cfg->chunk_size > 0 ? cfg->nr_s / cfg->chunk_size : 1;
+            serve_chunks(stream, cfg->chunk_size, queue_size, comm_sz, cp);
+        }
+        else{
+            // The results of the previous chunk are reported with the next request
+            long long report[3] = {0, 0, 0};
+            // Chunks received after the first solution was found are skipped by solve_rows
+            while (request_chunk(&batch, report)){
+                long long found = *sol_cnt, expanded = *sol_expanded;
+                long long nodes = *node_cnt;
+                start = MPI_Wtime();
+                solve_rows(cfg, layout, batch.values, row_length, start_index, 0, batch.cnt, my_rank, sol_cnt, sol_expanded, node_cnt, solution, table);
+                *busy += MPI_Wtime() - start;
+                report[0] = *sol_cnt - found;
+                report[1] = *sol_expanded - expanded;
+                report[2] = *node_cnt - nodes;
+                if (solution->found)
+                    announce_solution();
+            }
+        }
+    }
+    else{
+        // Every process takes the next batch of its share from its own stream, so no communication is needed
+        while (next_units(stream, cfg->nr_s, &batch) > 0){
+            start = MPI_Wtime();
+            solve_rows(cfg, layout, batch.values, row_length, start_index, 0, batch.cnt, my_rank, sol_cnt, sol_expanded, node_cnt, solution, table);
+            *busy += MPI_Wtime() - start;
+            if (solution->found)
+                announce_solution();
+            // Check whether another process found the first solution
+            poll_cancellation();
+            if (search_stopped())
+                break;
+        }
+    }
+    free_row_buffer(&batch);
+}
+
+void balance_work_units(const solver_config *cfg, const board_layout *layout, const row_buffer *units, int start_index, row_buffer *packed){
+    /* This function estimates the cost of every work unit by random probes and packs them, putting the ones of this process into packed from the most to the least expensive one.
+    With the static distribution the processes estimate every comm_sz-th work unit each and share the estimates, with the dynamic distribution the scheduler estimates all of them and keeps them all.
+    From the speed of the probes it predicts the runtime of the search, which the first process prints before the search starts.
+    */
+    int N = cfg->N, L = units->row_length;
+    int my_rank = 0, comm_sz = 1, threads = 1;
+    int i, j;
+    bool shared = cfg->parallel_exec && !cfg->dynamic;
+    if (cfg->parallel_exec){
+        MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    }
+    #ifdef _OPENMP
+        threads = omp_get_max_threads();
+    #endif
+    int share = shared ? my_rank : 0, shares = shared ? comm_sz : 1;
+    double *cost = calloc(units->cnt > 0 ? units->cnt : 1, sizeof(double));
+    // Tiles placed by the probes and the seconds they took over all threads, which give the speed of the engine
+    double probe[2] = {0.0, 0.0};
+    long long placed = 0;
+    double seconds = 0.0;
+
+    // Set aside what the threads counted before, as the probes count on the same counters
+    #ifdef HEX_STATS
+        search_stats search_before = {0};
+        collect_search_stats(&search_before);
+    #endif
+
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic) default(none) private(j) shared(N, L, cfg, layout, units, start_index, share, shares, cost) reduction(+:placed, seconds)
+    #endif
+    for (i = 0; i < units->cnt; i++){
+        if (i % shares != share)
+            continue;
+        int vals_to_solve[N];
+        for (j = 0; j < N; j++){
+            vals_to_solve[j] = 0;
+        }
+        for (j = 0; j < L; j++){
+            vals_to_solve[start_index + j] = units->values[(size_t)i * L + j];
+        }
+        // Work units which aren't canonical are skipped by the solver and cost nothing
+        search_state state;
+        if (!prepare_search(cfg, layout, vals_to_solve, &state))
+            continue;
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        cost[i] = estimate_nodes(&state, cfg->engine, cfg->estimate_probes, i, &placed);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds += get_time_diff(start, end);
+    }
+    probe[0] = placed;
+    probe[1] = seconds;
+    if (shared){
+        MPI_Allreduce(MPI_IN_PLACE, cost, units->cnt, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        MPI_Allreduce(MPI_IN_PLACE, probe, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    }
+    // The probes are not part of the search, so the statistics drop their counts and get back the ones counted before
+    #ifdef HEX_STATS
+        search_stats probe_stats = {0};
+        collect_search_stats(&probe_stats);
+        restore_search_stats(&search_before);
+    #endif
+
+    double total = 0.0, largest = 0.0, busiest = 0.0;
+    int cnt = units->cnt;
+    for (i = 0; i < cnt; i++){
+        total += cost[i];
+        if (cost[i] > largest)
+            largest = cost[i];
+    }
+    double loads[shares];
+    pack_work_units(units, cost, shares, share, loads, packed);
+    free(cost);
+
+    if (my_rank != 0)
+        return;
+    // The work is spread over the threads of the busiest process, or of all processes which ask the scheduler for work
+    if (shared){
+        for (i = 0; i < shares; i++){
+            if (loads[i] > busiest)
+                busiest = loads[i];
+        }
+        busiest /= threads;
+    }
+    else
+        busiest = total / ((cfg->parallel_exec && comm_sz > 1 ? comm_sz - 1 : 1) * threads);
+    // No process finishes before its most expensive work unit
+    if (busiest < largest)
+        busiest = largest;
+    double speed = probe[1] > 0.0 ? probe[0] / probe[1] : 0.0;
+    printf("Estimated %.3e nodes in %d work units with %d probes each, the most expensive work unit has %.3e nodes.\n", total, cnt, cfg->estimate_probes, largest);
+    if (speed > 0.0)
+        printf("Predicted runtime: %lf seconds on %d processes with %d threads at %.3e nodes per second and thread.\n", busiest / speed, comm_sz, threads, speed);
+}
+
+void share_work_units(row_buffer *units, node_window *window){
+    /* This function moves the work units the first process of the node collected into a window, which all processes of the node read them from.
+    Afterwards units lies in the window and must not be changed or freed, the window is released by close_node_window instead.
+    */
+    unsigned long long cnt = units->cnt;
+    MPI_Bcast(&cnt, 1, MPI_UNSIGNED_LONG_LONG, 0, node_comm);
+    int *values = open_node_window(cnt * units->row_length * sizeof(int), window);
+    if (node_rank() == 0){
+        memcpy(values, units->values, cnt * units->row_length * sizeof(int));
+        free_row_buffer(units);
+    }
+    publish_node_window(window);
+    units->values = values;
+    units->cnt = cnt;
+    units->capacity = cnt;
+}
+
+void open_work_units(const solver_config *cfg, const board_layout *layout, unit_stream *stream, node_window *window, int *start_index, long long *node_cnt){
+    /* This function opens the stream of work units of this process and sets the index of the first tile they are set on.
+    The work units are either the rows of distinct values adding up to M, the boards of the search frontier or the values of the first tile.
+    With the dynamic distribution the first process streams all work units to hand them out, otherwise the work units are split round robin among the processes and each one streams its own share.
+    Work units which have to be collected in full for the static distribution are collected once per node, by its first process into the window all processes of the node stream their share from.
+    The window stays open until close_work_units, unless the work units are packed, as then every process keeps a copy of only its own packed share.
+    */
+    int n = cfg->n, N = cfg->N, N_s = cfg->N_s;
+    int my_rank = 0, comm_sz = 1;
+    int i, k;
+    if (cfg->parallel_exec){
+        MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    }
+    int stride = comm_sz, offset = my_rank;
+    if (cfg->dynamic){
+        stride = 1;
+        offset = 0;
+    }
+
+    window->base = NULL;
+    *start_index = 0;
+    if (cfg->precomputed_row >= 0){
+        // Calculate the index of the first position of the precomputed combinations
+        for (k = 0; k < cfg->precomputed_row; k++){
+            *start_index += n;
+            *start_index += k;
+        }
+        if (cfg->estimate_probes == 0){
+            open_row_stream(stream, n + cfg->precomputed_row, N, N_s, cfg->M, stride, offset, cfg->index);
+            return;
+        }
+    }
+
+    // With the static distribution every process needs all work units to find its share, with the dynamic one only the scheduler does
+    bool on_node = cfg->parallel_exec && !cfg->dynamic;
+    bool collect = cfg->dynamic ? my_rank == 0 : !on_node || node_rank() == 0;
+    row_buffer units;
+    if (cfg->precomputed_row >= 0){
+        // The work units can only be packed once all of them are known, so the rows are collected from their stream
+        init_row_buffer(&units, n + cfg->precomputed_row);
+        if (collect){
+            unit_stream rows;
+            row_buffer batch;
+            open_row_stream(&rows, n + cfg->precomputed_row, N, N_s, cfg->M, 1, 0, cfg->index);
+            init_row_buffer(&batch, rows.row_length);
+            while (next_units(&rows, cfg->nr_s, &batch) > 0){
+                for (i = 0; i < batch.cnt; i++){
+                    append_row(&units, batch.values + (size_t)i * batch.row_length);
                 }
-                (*cnt)++;
-                // Only generate a limited number of starting rows
-                if (*cnt == nr_s)
-                    return false;
+            }
+            free_row_buffer(&batch);
+            close_stream(&rows);
+        }
+    }
+    else if (cfg->precomputed_row == FRONTIER_ROW){
+        // The boards of the frontier cover all tiles, empty ones are 0
+        init_row_buffer(&units, N);
+        // Expanding the first levels is cheap compared to solving the boards, so every node which needs them does it on its own
+        if (collect){
+            int vals_to_solve[N];
+            for (i = 0; i < N; i++){
+                vals_to_solve[i] = 0;
+            }
+            search_state root;
+            if (prepare_search(cfg, layout, vals_to_solve, &root)){
+                long long nodes = build_frontier(&root, cfg->engine, cfg->frontier_depth, cfg->frontier_target, &units);
+                // The tiles placed while expanding are only counted once, the first process is always the first one of its node
+                if (my_rank == 0)
+                    *node_cnt += nodes;
             }
         }
     }
+    else{
+        // Each possible value of the first tile is a work unit of length one
+        init_row_buffer(&units, 1);
+        for (i = 0; i < N && collect; i++){
+            int value = i + N_s;
+            append_row(&units, &value);
+        }
+    }
+    if (cfg->estimate_probes == 0 && !on_node){
+        open_buffer_stream(stream, &units, stride, offset);
+        return;
+    }
 
-    return true;
+    if (on_node)
+        share_work_units(&units, window);
+    // Without packing, every process streams its round robin share right out of the window
+    if (cfg->estimate_probes == 0){
+        open_borrowed_stream(stream, &units, stride, offset);
+        return;
+    }
+    // This process keeps its own share of the work units, packed by their estimated cost
+    row_buffer share;
+    if (!cfg->dynamic || my_rank == 0)
+        balance_work_units(cfg, layout, &units, *start_index, &share);
+    else
+        init_row_buffer(&share, units.row_length);
+    if (on_node)
+        close_node_window(window);
+    else
+        free_row_buffer(&units);
+    open_buffer_stream(stream, &share, 1, 0);
+}
+
+void close_work_units(unit_stream *stream, node_window *window){
+    /* This function closes the stream opened by open_work_units and the window its work units were shared in, if they still are.
+    All processes of the node have to call this function together if the work units were shared.
+    */
+    close_stream(stream);
+    if (window->base != NULL)
+        close_node_window(window);
+}
+
+void collect_first_solution(const solver_config *cfg, const board_layout *layout, first_solution *solution, long long *sol_cnt, long long *sol_expanded){
+    /* This function ends the search for the first solution on all processes and prints the solution of the process with the smallest rank which found one on the first process.
+    The solution is counted on the first process only, so sol_cnt and sol_expanded are reset on all others.
+    */
+    int r = cfg->r;
+    int size = layout != NULL ? cfg->N : r * r * r;
+    int my_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+
+    int winner = finish_cancellation();
+    // Send the solution to the first process if it didn't find it itself
+    if (winner > 0 && my_rank == winner)
+        MPI_Send(solution->values, size, MPI_INT, 0, TAG_SOLUTION, MPI_COMM_WORLD);
+    else if (winner > 0 && my_rank == 0)
+        MPI_Recv(solution->values, size, MPI_INT, winner, TAG_SOLUTION, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    *sol_cnt = 0;
+    *sol_expanded = 0;
+    if (my_rank != 0)
+        return;
+    if (winner < 0){
+        printf("Solver was not able to find a solution for this board!\n");
+        return;
+    }
+    printf("Solver found a solution!\nThis is the solution he found:\n");
+    print_solution(r, cfg->n, layout, solution->values, (int (*)[r][r])solution->values);
+    *sol_cnt = 1;
+    *sol_expanded = layout != NULL && cfg->symmetry ? count_symmetric_boards(layout, solution->values) : 1;
+}
+
+void open_checkpoint(const solver_config *cfg, checkpoint *cp, long long *sol_cnt, long long *sol_expanded, long long *node_cnt){
+    /* This function initializes the checkpoint of the work units and, if we resume, loads it and adds the results of the completed work units.
+    Only the process which keeps track of the completed work units writes the checkpoint, which is the first one with the dynamic distribution.
+    */
+    int my_rank = 0, comm_sz = 1;
+    if (cfg->parallel_exec){
+        MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    }
+    bool tracked = my_rank == 0 && (!cfg->parallel_exec || (cfg->dynamic && comm_sz > 1));
+    // The work units and their order depend on these parameters
+    int params[CHECKPOINT_PARAMS] = {cfg->n, cfg->N_s, cfg->M, cfg->precomputed_row, cfg->frontier_depth, cfg->frontier_target, cfg->engine, cfg->symmetry, cfg->check_partial, cfg->flat_layout, cfg->estimate_probes, cfg->use_index};
+    init_checkpoint(cp, tracked ? cfg->checkpoint_path : NULL, cfg->checkpoint_interval, params);
+    checkpoint_status status = cp->path != NULL && cfg->resume ? load_checkpoint(cp) : CHECKPOINT_MISSING;
+    // Starting over would overwrite the progress of the run which wrote the checkpoint
+    if (status == CHECKPOINT_MISMATCH){
+        printf("The checkpoint %s doesn't match the parameters of the solver, resume with the parameters it was written with or choose another file!\n", cfg->checkpoint_path);
+        fflush(stdout);
+        if (cfg->parallel_exec)
+            MPI_Abort(MPI_COMM_WORLD, -1);
+        exit(-1);
+    }
+    if (status == CHECKPOINT_LOADED){
+        printf("Resuming from %s with %lld completed work units.\n", cfg->checkpoint_path, cp->done_cnt);
+        *sol_cnt += cp->sol_cnt;
+        *sol_expanded += cp->sol_expanded;
+        *node_cnt += cp->nodes;
+    }
+}
+
+void write_unit_results(const solver_config *cfg, unit_table *table){
+    /* This function collects the results of the work units of all processes on the first process, which writes them to the file selected on the command line, and releases the table.
+    It also prints how long the slowest work unit took compared to all of them together.
+    */
+    int my_rank = 0, k, slowest = 0;
+    double total = 0.0;
+    if (cfg->unit_stats_path == NULL)
+        return;
+    if (cfg->parallel_exec){
+        MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+        gather_unit_table(table);
+    }
+    if (my_rank == 0 && write_unit_table(table, cfg->unit_stats_path) && table->units.cnt > 0){
+        for (k = 0; k < table->units.cnt; k++){
+            total += table->seconds[k];
+            if (table->seconds[k] > table->seconds[slowest])
+                slowest = k;
+        }
+        printf("The results of %d work units were written to %s, the slowest one took %lf of %lf seconds.\n", table->units.cnt, cfg->unit_stats_path, table->seconds[slowest], total);
+    }
+    free_unit_table(table);
+}
+
+long long solve_meet(const solver_config *cfg, const board_layout *layout, solver_stats *stats){
+    /* This function solves the board with the meet-in-the-middle solver, where every process joins its share of the upper halves with all lower halves.
+    If we only want to find the first solution, the process which finds one tells all other processes to stop and the first process prints it.
+    */
+    int N = cfg->N;
+    int my_rank = 0, comm_sz = 1;
+    if (cfg->parallel_exec){
+        MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+    }
+    int vals_to_solve[N];
+    int i;
+    for (i = 0; i < N; i++){
+        vals_to_solve[i] = 0;
+    }
+    meet_options opt = {
+        .memory_cap = cfg->meet_memory, .spill_dir = cfg->spill_dir,
+        .stride = comm_sz, .offset = my_rank,
+        .report = my_rank == 0 && cfg->verbosity > 0
+    };
+    task_results res;
+    memset(&res, 0, sizeof(task_results));
+
+    if (cfg->parallel_exec && !cfg->find_all)
+        start_cancellation();
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    search_state root;
+    if (prepare_search(cfg, layout, vals_to_solve, &root))
+        search_meet(&root, &opt, &res);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    stats->busy += get_time_diff(start, end);
+    stats->nodes += res.nodes;
+
+    if (cfg->find_all){
+        stats->sol_expanded += res.sol_expanded;
+        return res.sol_cnt;
+    }
+    if (cfg->parallel_exec){
+        int solution_values[N];
+        first_solution solution = {false, solution_values};
+        long long sol_cnt, sol_expanded;
+        if (res.found){
+            record_solution(&solution, N, res.cells);
+            announce_solution();
+        }
+        collect_first_solution(cfg, layout, &solution, &sol_cnt, &sol_expanded);
+        stats->sol_expanded += sol_expanded;
+        return sol_cnt;
+    }
+    if (res.found){
+        printf("Solver found a solution!\nThis is the solution he found:\n");
+        print_flat_board(layout, res.cells);
+        return 1;
+    }
+    printf("Solver was not able to find a solution for this board!\n");
+    return 0;
 }
 
-int solver(int n, int r, int N_s, int N, int M, bool find_all, int precomputed_row, int nr_s, bool parallel_exec, bool check_partial, bool print_solutions, int verbosity, int benchmark){
+long long solver(const solver_config *cfg, solver_stats *stats){
     /* This function is the main function of the solver. It initializes the board to solve and calls the solver_depth_first function. The mutidimensional-array storing the current board is initialized with 0's and dependent on the solver varaint chosen either the first tile or a full row will have a precomputed value assigned before solving the rest of the tiles.
     The representation of the board is inspired by: https://www.redblobgames.com/grids/hexagons/
+    The number of placed tiles, of solutions including symmetric ones and the time spent solving are added to stats.
     */
+    int n = cfg->n, r = cfg->r, N_s = cfg->N_s, N = cfg->N;
+    bool find_all = cfg->find_all, parallel_exec = cfg->parallel_exec;
+    int precomputed_row = cfg->precomputed_row, nr_s = cfg->nr_s;
 
     // This is the board to solve
     int board[r][r][r];
+    // This is the board to solve if the flat representation is used
+    int cells[N];
+    board_layout flat;
+    board_layout *layout = NULL;
+    if (cfg->flat_layout){
+        init_board_layout(&flat, n);
+        layout = &flat;
+        // The specialized engines read their own copy of the line tables, which must not differ from the layout
+        if (cfg->specialized && !kernel_tables_match(layout)){
+            printf("The line tables of the specialized engines don't match the board of side length %d, run with -x0!\n", n);
+            fflush(stdout);
+            if (cfg->parallel_exec)
+                MPI_Abort(MPI_COMM_WORLD, -1);
+            exit(-1);
+        }
+    }
     // This array holds the values which we will initially set on the board
     int vals_to_solve[N];
     int i;
@@ -152,236 +847,254 @@ int solver(int n, int r, int N_s, int N, int M, bool find_all, int precomputed_r
     bool value_used[N];
 
     // A counter which counts the number of found solutions
-    int sol_cnt = 0;
+    long long sol_cnt = 0;
+    // A counter which counts the number of found solutions including their rotations and reflections
+    long long sol_expanded = 0;
+    // A counter which counts the number of placed tiles
+    long long node_cnt = 0;
+    // The first solution found by this process if executed in parallel
+    int solution_values[layout != NULL ? N : r * r * r];
+    first_solution solution = {false, solution_values};
+
+    // The meet-in-the-middle solver enumerates the halves of the board itself instead of solving work units
+    if (cfg->engine == ENGINE_MEET)
+        return solve_meet(cfg, layout, stats);
+
+    // If we want to use precomputed combinations for a specific row or the frontier of the search, choose this branch
+    if (precomputed_row >= 0 || precomputed_row == FRONTIER_ROW){
+        // The work units are streamed in batches, so they never have to be held in memory all at once
+        unit_stream stream;
+        node_window window;
+        int start_index;
+        open_work_units(cfg, layout, &stream, &window, &start_index, &node_cnt);
+        int row_length = stream.row_length;
+        // The completed work units
+        checkpoint cp;
+        open_checkpoint(cfg, &cp, &sol_cnt, &sol_expanded, &node_cnt);
+        // The results of each work unit, if they are collected
+        unit_table units_solved;
+        init_unit_table(&units_solved, row_length);
+        unit_table *table = cfg->unit_stats_path != NULL ? &units_solved : NULL;
 
-    // If we want to use precomputed combinations for a specific row, choose this branch
-    if (precomputed_row >= 0){
         // If executed in parallel split the tasks
         if (parallel_exec){
-            // Get the number of processes
-            int comm_sz;
-            MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
+            // Distribute the precomputed combinations among the processes and solve them
+            if (!find_all)
+                start_cancellation();
+            solve_distributed(cfg, layout, &stream, start_index, &sol_cnt, &sol_expanded, &node_cnt, &stats->busy, &solution, &cp, table);
 
-            // Get the rank of the process
+            // Add up the number of work units the processes took from their streams
+            long long cnt;
+            MPI_Reduce(&stream.cnt, &cnt, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
             int my_rank;
             MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
-
-            // Calculate the length of the row we are precomputing
-            int row_length = n + precomputed_row;
-            // This array holds the precomputed combinations
-            int starting_row[nr_s * row_length];
-            // The number of precomputed combinations
-            int cnt;
-            // Calculate possible starting row combinations on the first process
             if (my_rank == 0){
-                int prev_nrs[row_length];
-                cnt = 0;
-
-                // Calculate possible starting row combinations
-                bool ret_generator = generate_starting_row(row_length, N, N_s, M, nr_s, starting_row, prev_nrs, 0, &cnt);
-
-                if (!ret_generator){
-                    printf("The number of possible starting rows exceeds the number selected!\nChoose a larger number to generate all starting rows.\n");
-                }
-                
-                printf("Number of possible starting rows: %d\n", cnt);
-
-            }
-            // Broadcast the number of precomputed combinations to all processes
-            MPI_Bcast(&cnt, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-            // Calculate how many positions per process have to be calculated. Only works if the number of processes is a divisor of the number of possible combinations
-            if (benchmark != 2 && cnt % comm_sz != 0){
-                if (my_rank == 0){
-                    printf("The number of processes (%d) has to be a divisor of the number of possible values (%d)!\n", comm_sz, cnt);
-                }
-                return 0;
+                if (precomputed_row == FRONTIER_ROW)
+                    printf("Number of boards in the search frontier: %lld\n", cnt);
+                else
+                    printf("Number of possible starting rows: %lld\n", cnt);
             }
-            int share = (int)(cnt / comm_sz);
-
-            // Distribute the respective shares of precomputed combinations to all processes
-            int local_starting_row[share * row_length];
-            MPI_Scatter(starting_row, share * row_length, MPI_INT, local_starting_row, share * row_length, MPI_INT, 0, MPI_COMM_WORLD);
-
-            int j, k;
-            int visited = 0;
+            // If we only want to find the first solution, collect it on the first process
+            if (!find_all)
+                collect_first_solution(cfg, layout, &solution, &sol_cnt, &sol_expanded);
+            write_unit_results(cfg, table);
+        }
+        // Sequential execution
+        else{
+            row_buffer batch;
+            init_row_buffer(&batch, row_length);
+            int j;
             bool ret_solver;
-            // Calculate the index of the first position of the precomputed combinations
-            int start_index = 0;
-            for (k = 0; k < precomputed_row; k++){
-                start_index += n;
-                start_index += k;
-            }
-
-            // Only use OpenMP if we can access the API. If so, parallelize the loop over the precomputed combinations
-            #ifdef _OPENMP
-                #pragma omp parallel for default(none) private(j, value_used, board, ret_solver) firstprivate(vals_to_solve, visited) shared(N, share, r, n, row_length, N_s, M, print_solutions, local_starting_row, my_rank, verbosity, find_all, start_index, check_partial) reduction(+:sol_cnt)
-            #endif
-            // Loop over the assigned precomputed combinations of this process
-            for (i = 0; i < share; i++){
-                // Print out the process and the CPU it is running on as well as the thread if OpenMP is used
-                if (verbosity > 1 && visited == 0){
-                    #ifdef _OPENMP
-                        #pragma omp critical
-                        {
-                            printf("Thread %d of process %d on CPU %d\n", omp_get_thread_num(), my_rank, sched_getcpu());
-                            if (verbosity > 2)
-                                print_board(r,n,board);
-                        }
-                    #else
-                        printf("Process %d on CPU %d\n", my_rank, sched_getcpu());
-                    #endif
-                    visited = 1;
-                }
-
-                // Fill the board with the values of the precomputed combination
-                fill_value_list(N, value_used);
-                for (j = 0; j < row_length; j++){
-                    vals_to_solve[start_index + j] = local_starting_row[i * row_length + j];
-                    value_used[local_starting_row[i * row_length + j] - N_s] = true;
-                }
-                fill_board(vals_to_solve, r, n, board);
+            // Loop over all precomputed combinations, one batch at a time
+            while (next_units(&stream, nr_s, &batch) > 0){
+                for (i = 0; i < batch.cnt; i++){
+                    // Skip the work units completed before we resumed
+                    long long index = stream.cnt - batch.cnt + i;
+                    if (unit_done(&cp, index))
+                        continue;
+                    const int *row = batch.values + (size_t)i * row_length;
+                    // Fill the board with the values of the precomputed combination
+                    fill_value_list(N, value_used);
+                    for (j = 0; j < row_length; j++){
+                        vals_to_solve[start_index + j] = row[j];
+                        if (row[j] > 0)
+                            value_used[row[j] - N_s] = true;
+                    }
 
-                // Call the solver
-                ret_solver = solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, &sol_cnt);
+                    // Call the solver
+                    long long found = sol_cnt, expanded = sol_expanded;
+                    long long nodes = node_cnt;
+                    struct timespec unit_start, unit_end;
+                    clock_gettime(CLOCK_MONOTONIC, &unit_start);
+                    ret_solver = solve_board(cfg, layout, vals_to_solve, cells, board, value_used, &sol_cnt, &sol_expanded, &node_cnt);
+                    clock_gettime(CLOCK_MONOTONIC, &unit_end);
+                    if (table != NULL)
+                        add_unit_result(table, row, 0, sol_cnt - found, node_cnt - nodes, get_time_diff(unit_start, unit_end));
 
-                // If we only want to find the first solution, we can abort the program if we found one
-                if (!find_all){
-                    if (ret_solver){
+                    // If we only want to find the first solution, we can abort the program if we found one
+                    if (!find_all && ret_solver){
                         printf("Solver found a solution!\nThis is the solution he found:\n");
-                        print_board(r, n, board);
-                        MPI_Abort(MPI_COMM_WORLD, 1);
+                        print_solution(r, n, layout, cells, board);
+                        write_unit_results(cfg, table);
+                        free_row_buffer(&batch);
+                        close_work_units(&stream, &window);
+                        free_checkpoint(&cp);
+                        stats->nodes += node_cnt;
+                        stats->sol_expanded += sol_expanded;
+                        return 1;
                     }
+                    // Record the completed work unit and write the checkpoint if it is due
+                    complete_unit(&cp, index);
+                    add_checkpoint_results(&cp, sol_cnt - found, sol_expanded - expanded, node_cnt - nodes);
+                    update_checkpoint(&cp, false);
                 }
             }
-        }
-        // Sequential execution
-        else{
-            // Calculate the length of the row we are precomputing
-            int row_length = n + precomputed_row;
-            // This array holds the precomputed combinations
-            int starting_row[nr_s * row_length];
-            int prev_nrs[row_length];
-            // The number of precomputed combinations
-            int cnt = 0;
-
-            // Calculate possible starting row combinations
-            bool ret_generator = generate_starting_row(row_length, N, N_s, M, nr_s, starting_row, prev_nrs, 0, &cnt);
-
-            if (!ret_generator){
-                printf("The number of possible starting rows exceeds the number selected!\nChoose a larger number to generate all starting rows.\n");
-            }
-            
-            printf("Number of possible starting rows: %d\n", cnt);
+            free_row_buffer(&batch);
+            update_checkpoint(&cp, true);
+            write_unit_results(cfg, table);
 
-            int j, k;
-            bool ret_solver;
-            // Calculate the index of the first position of the precomputed combinations
-            int start_index = 0;
-            for (k = 0; k < precomputed_row; k++){
-                start_index += n;
-                start_index += k;
-            }
-            // Loop over all precomputed combinations
-            for (i = 0; i < cnt; i++){
-                // Fill the board with the values of the precomputed combination
-                fill_value_list(N, value_used);
-                for (j = 0; j < row_length; j++){
-                    vals_to_solve[start_index + j] = starting_row[i * row_length + j];
-                    value_used[starting_row[i * row_length + j] - N_s] = true;
-                }
-                fill_board(vals_to_solve, r, n, board);
+            if (precomputed_row == FRONTIER_ROW)
+                printf("Number of boards in the search frontier: %lld\n", stream.cnt);
+            else
+                printf("Number of possible starting rows: %lld\n", stream.cnt);
 
-                // Call the solver
-                ret_solver = solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, &sol_cnt);
-                
-                // If we only want to find the first solution, we can abort the program if we found one
-                if (!find_all && ret_solver){
-                    printf("Solver found a solution!\nThis is the solution he found:\n");
-                    print_board(r, n, board);
-                    return 1;
-                }
-            }
             // We didn't find any solution
             if (!find_all){
                 printf("Solver was not able to find a solution for this board!\n");
+                close_work_units(&stream, &window);
+                free_checkpoint(&cp);
+                stats->nodes += node_cnt;
+                stats->sol_expanded += sol_expanded;
                 return 0;
             }
         }
+        close_work_units(&stream, &window);
+        free_checkpoint(&cp);
         // Return the number of found solutions
+        stats->nodes += node_cnt;
+        stats->sol_expanded += sol_expanded;
         return sol_cnt;
     }
     // If we don't want to use precomputed combinations, choose this branch
     else{
         // If executed in parallel split the tasks
         if (parallel_exec){
-            // Get the number of processes
-            int comm_sz;
-            MPI_Comm_size(MPI_COMM_WORLD, &comm_sz);
-
-            // Get the rank of the process
-            int my_rank;
-            MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
-
-            // Calculate how many values per process have to be calculated. Only works if the number of processes is a divisor of the number of values
-            if (benchmark != 2 && N % comm_sz != 0){
-                if (my_rank == 0){
-                    printf("The number of processes (%d) has to be a divisor of the number of possible values (%d)!\n", comm_sz, N);
-                }
-                return 0;
-            }
-            int share = (int)(N / comm_sz);
-            bool ret_solver;
-
-            // Loop over the assigned values of this process
-            for (i = my_rank * share; i < (my_rank + 1) * share; i++){
-                // Fill the first tile with the respective value
-                fill_value_list(N, value_used);
-                vals_to_solve[0] = i + N_s;
-                value_used[i] = true;
-                fill_board(vals_to_solve, r, n, board);
-
-                // Call the solver
-                ret_solver = solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, &sol_cnt);
+            // Each possible value of the first tile is a work unit
+            unit_stream stream;
+            node_window window;
+            int start_index;
+            open_work_units(cfg, layout, &stream, &window, &start_index, &node_cnt);
+            checkpoint cp;
+            open_checkpoint(cfg, &cp, &sol_cnt, &sol_expanded, &node_cnt);
+            unit_table units_solved;
+            init_unit_table(&units_solved, stream.row_length);
+            unit_table *table = cfg->unit_stats_path != NULL ? &units_solved : NULL;
 
-                // If we only want to find the first solution, we can abort the program if we found one
-                if (!find_all){
-                    if (ret_solver){
-                        printf("Solver found a solution!\nThis is the solution he found:\n");
-                        print_board(r, n, board);
-                        MPI_Abort(MPI_COMM_WORLD, 1);
-                        return 1;
-                    }
-                }
-            }
+            // Distribute the values of the first tile among the processes and solve them
+            if (!find_all)
+                start_cancellation();
+            solve_distributed(cfg, layout, &stream, start_index, &sol_cnt, &sol_expanded, &node_cnt, &stats->busy, &solution, &cp, table);
+            close_work_units(&stream, &window);
+            free_checkpoint(&cp);
+            // If we only want to find the first solution, collect it on the first process
+            if (!find_all)
+                collect_first_solution(cfg, layout, &solution, &sol_cnt, &sol_expanded);
+            write_unit_results(cfg, table);
         }
         // Sequential execution
         else{
             // Prepare the board by setting all tiles to 0
-            fill_board(vals_to_solve, r, n, board);
             fill_value_list(N, value_used);
 
             // Call the solver
-            bool ret_solver = solver_depth_first(r, n, N, N_s, M, board, value_used, check_partial, find_all, print_solutions, &sol_cnt);
+            bool ret_solver = solve_board(cfg, layout, vals_to_solve, cells, board, value_used, &sol_cnt, &sol_expanded, &node_cnt);
 
             // If we only want to find the first solution, we can abort the program if we found one
             if (!find_all){
                 if (ret_solver){
                     printf("Solver found a solution!\nThis is the solution he found:\n");
-                    print_board(r, n, board);
+                    print_solution(r, n, layout, cells, board);
+                    stats->nodes += node_cnt;
+                    stats->sol_expanded += sol_expanded;
                     return 1;
                 }
                 else{
                     printf("Solver was not able to find a solution for this board!\n");
+                    stats->nodes += node_cnt;
+                    stats->sol_expanded += sol_expanded;
                     return 0;
                 }
             }
         }
         // Return the number of found solutions
+        stats->nodes += node_cnt;
+        stats->sol_expanded += sol_expanded;
         return sol_cnt;
     }
 }
 
+bool share_line_index(const solver_config *cfg, line_index *index, node_window *window){
+    /* This function builds the index on the first process of every node and places it in a window, which all processes of the node read it from.
+    The other processes receive the counts of the sets and place the index in the window the same way. It returns false on all processes of the node if the index would be too large.
+    */
+    line_index built;
+    bool ok = true;
+    if (node_rank() == 0){
+        ok = build_line_index(&built, cfg->n, cfg->N_s, cfg->M);
+        *index = built;
+    }
+    MPI_Bcast(&ok, 1, MPI_C_BOOL, 0, node_comm);
+    if (!ok)
+        return false;
+    // Only the counts are used, the addresses of the sets of the first process mean nothing in the others
+    MPI_Bcast(index, sizeof(line_index), MPI_BYTE, 0, node_comm);
+    place_line_index(index, open_node_window(line_index_bytes(index), window));
+    if (node_rank() == 0){
+        copy_line_index(index, &built);
+        free_line_index(&built);
+    }
+    publish_node_window(window);
+    return true;
+}
+
+void prepare_line_index(solver_config *cfg, line_index *index, node_window *window, bool report){
+    /* This function builds the index of the valid lines for the line sum of the configuration if it is used.
+    In parallel execution a window is given, in which the index is built once per node instead of once per process.
+    If the index would be too large or the values don't fit into a value set, only the bounds of the line sums are used, which is reported if report is set.
+    */
+    cfg->index = NULL;
+    if (!cfg->use_index)
+        return;
+    if (cfg->N > VALSET_BITS){
+        if (report)
+            printf("The index of the valid lines supports at most %d values, only the bounds of the line sums are used.\n", VALSET_BITS);
+        return;
+    }
+    if (window != NULL ? share_line_index(cfg, index, window) : build_line_index(index, cfg->n, cfg->N_s, cfg->M))
+        cfg->index = index;
+    else if (report)
+        printf("The index of the valid lines would hold more than %d sets, only the bounds of the line sums are used.\n", LINE_INDEX_MAX_SETS);
+}
+
+void release_line_index(solver_config *cfg, line_index *index, node_window *window){
+    /* This function releases the index built by prepare_line_index and the window it was placed in.
+    */
+    if (window != NULL && cfg->index != NULL)
+        close_node_window(window);
+    free_line_index(index);
+    cfg->index = NULL;
+}
+
+void write_distinct_solutions(const char *path, int n, int ranks){
+    /* This function replaces the solutions the processes wrote by one solution of each set of rotated and reflected solutions in path.
+    */
+    board_layout layout;
+    init_board_layout(&layout, n);
+    long long distinct = deduplicate_solutions(path, ranks, &layout);
+    if (distinct >= 0)
+        printf("%lld distinct solutions up to rotations and reflections were written to %s.\n", distinct, path);
+}
+
 int main(int argc, char** argv) {
     /* This is the main function of the programm. It reads out the command line arguments and calls the solver function.
     */
@@ -398,13 +1111,13 @@ int main(int argc, char** argv) {
     int M = 38;
     // Whether we want to find all solutions or only the first one
     bool find_all = false;
-    // Max number of precomputed combinations of the first row we are looking at
+    // Number of work units which are generated and held in memory at once
     int nr_s = 1000;
     // Whether to run the code in parallel
     bool parallel_execution = false;
     // Whether to check for partial validity
     bool check_partial = true;
-    // Which row do we precalculate (only choose from the first half), if none then set to -1
+    // Which row do we precalculate (only choose from the first half), if none then set to -1, -2 to use the search frontier instead
     int starting_rows_calc = 0;
     // Whether to print out the found solutions
     bool print_solutions = false;
@@ -412,10 +1125,58 @@ int main(int argc, char** argv) {
     int verbosity = 0;
     // Select the benchmark we are running
     int benchmark = 1;
+    // Whether to use the flat board representation instead of the r x r x r cube
+    bool flat_layout = true;
+    // The search engine used on the flat board representation (0 = row-major DFS, 1 = complete lines first, 2 = row-major DFS on an explicit stack, 3 = meet-in-the-middle)
+    int engine = ENGINE_ROW_MAJOR;
+    // Whether to only search one representative of each set of rotated and reflected boards
+    bool symmetry = false;
+    // Whether to use the engines specialized for the size of the hexagon (n = 2 to 5) instead of the generic ones
+    bool specialized = true;
+    // Whether to precompute all sets of values which add up to M for every line length and restrict the values of the tiles to them
+    bool use_index = false;
+    // Number of remaining boards each thread remembers as a power of two, 0 to not look them up
+    int memo_size = 0;
+    // Whether to hand out the work units to the processes on request and how many at once
+    bool dynamic = false;
+    int chunk_size = 1;
+    // Number of levels below each work unit which spawn OpenMP tasks, -1 to use a parallel loop over the work units instead
+    int task_depth = -1;
+    // Number of levels of the search frontier used as work units and the number of boards at which its expansion stops, 0 for no limit
+    int frontier_depth = 3;
+    int frontier_target = 0;
+    // The file the progress is written to, the seconds between two checkpoints and whether to resume from the file
+    const char *checkpoint_path = NULL;
+    int checkpoint_interval = 60;
+    bool resume = false;
+    // The file the results of every work unit are written to, NULL if they aren't collected
+    const char *unit_stats_path = NULL;
+    // The file the found solutions are written to instead of the console and whether to keep one of each set of symmetric solutions
+    const char *solutions_path = NULL;
+    bool dedup = false;
+    // Megabytes the meet-in-the-middle solver keeps in memory before it writes the halves to disk, and the directory of these files
+    long meet_memory = 1024;
+    const char *spill_dir = NULL;
+    // Number of random probes which estimate the cost of every work unit, 0 to not pack the work units
+    int estimate_probes = 0;
+
+    // The options which only have a long name
+    static struct option long_options[] = {
+        {"checkpoint", required_argument, NULL, OPT_CHECKPOINT},
+        {"checkpoint-interval", required_argument, NULL, OPT_CHECKPOINT_INTERVAL},
+        {"resume", no_argument, NULL, OPT_RESUME},
+        {"unit-stats", required_argument, NULL, OPT_UNIT_STATS},
+        {"solutions", required_argument, NULL, OPT_SOLUTIONS},
+        {"dedup", no_argument, NULL, OPT_DEDUP},
+        {"meet-memory", required_argument, NULL, OPT_MEET_MEMORY},
+        {"spill-dir", required_argument, NULL, OPT_SPILL_DIR},
+        {"estimate", required_argument, NULL, OPT_ESTIMATE},
+        {NULL, 0, NULL, 0}
+    };
 
     // Read out command line arguments if supplied
     int opt;
-    while ((opt = getopt(argc, argv, "n:s::M:a:l::p::r::o::v::c::b::")) != -1){
+    while ((opt = getopt_long(argc, argv, "n:s::M:a:l::p::r::o::v::c::b::f::e::y::d::k::t::u::g::x::i::m::", long_options, NULL)) != -1){
         switch (opt){
             case 'n':
                 n = atoi(optarg);
@@ -452,6 +1213,66 @@ int main(int argc, char** argv) {
             case 'b':
                 benchmark = atoi(optarg);
                 break;
+            case 'f':
+                flat_layout = atoi(optarg);
+                break;
+            case 'e':
+                engine = atoi(optarg);
+                break;
+            case 'y':
+                symmetry = atoi(optarg);
+                break;
+            case 'd':
+                dynamic = atoi(optarg);
+                break;
+            case 'k':
+                chunk_size = atoi(optarg);
+                break;
+            case 't':
+                task_depth = atoi(optarg);
+                break;
+            case 'u':
+                frontier_depth = atoi(optarg);
+                break;
+            case 'g':
+                frontier_target = atoi(optarg);
+                break;
+            case 'x':
+                specialized = atoi(optarg);
+                break;
+            case 'i':
+                use_index = atoi(optarg);
+                break;
+            case 'm':
+                memo_size = atoi(optarg);
+                break;
+            case OPT_CHECKPOINT:
+                checkpoint_path = optarg;
+                break;
+            case OPT_CHECKPOINT_INTERVAL:
+                checkpoint_interval = atoi(optarg);
+                break;
+            case OPT_RESUME:
+                resume = true;
+                break;
+            case OPT_UNIT_STATS:
+                unit_stats_path = optarg;
+                break;
+            case OPT_SOLUTIONS:
+                solutions_path = optarg;
+                break;
+            case OPT_DEDUP:
+                dedup = true;
+                break;
+            case OPT_MEET_MEMORY:
+                meet_memory = atol(optarg);
+                break;
+            case OPT_SPILL_DIR:
+                spill_dir = optarg;
+                break;
+            case OPT_ESTIMATE:
+                estimate_probes = atoi(optarg);
+                break;
             
             default:
                 printf("Command line argument could not be understood!\n");
@@ -459,6 +1280,109 @@ int main(int argc, char** argv) {
         }
     }
 
+    // The flat board representation only supports hexagons up to a maximum size and as many values as fit into a value set
+    if (flat_layout && (n > HEX_MAX_N || N > VALSET_BITS)){
+        printf("The flat board representation supports at most n = %d and %d values, use -f0 for larger boards!\n", HEX_MAX_N, VALSET_BITS);
+        exit(0);
+    }
+    // Symmetry breaking is only implemented for the flat board representation
+    if (symmetry && !flat_layout){
+        printf("Symmetry breaking requires the flat board representation, use -f1!\n");
+        exit(0);
+    }
+    // Only the scheduler of the dynamic distribution knows which work units are completed, so checkpoints use it
+    if (checkpoint_path != NULL && parallel_execution){
+        dynamic = true;
+    }
+    if (checkpoint_path != NULL && benchmark == 2){
+        printf("Checkpoints are not supported for benchmark 2, use -b1!\n");
+        exit(0);
+    }
+    // Without precomputed rows the sequential solver has no work units whose progress could be kept
+    if (checkpoint_path != NULL && starting_rows_calc < 0 && starting_rows_calc != FRONTIER_ROW && !parallel_execution){
+        printf("Checkpoints require work units, use -r0 or -r-2!\n");
+        exit(0);
+    }
+    if (resume && checkpoint_path == NULL){
+        printf("Resuming requires a checkpoint, use --checkpoint!\n");
+        exit(0);
+    }
+    // Without precomputed rows the sequential solver searches the whole board as a single work unit
+    if (unit_stats_path != NULL && starting_rows_calc < 0 && starting_rows_calc != FRONTIER_ROW && !parallel_execution){
+        printf("The results per work unit require work units, use -r0 or -r-2!\n");
+        exit(0);
+    }
+    if (unit_stats_path != NULL && benchmark == 2){
+        printf("The results per work unit are not supported for benchmark 2, use -b1!\n");
+        exit(0);
+    }
+    // Writing the solutions to a file implies printing them, which is only done if we search for all of them
+    if (solutions_path != NULL)
+        print_solutions = true;
+    if (dedup && (solutions_path == NULL || n > HEX_MAX_N)){
+        printf("Removing symmetric solutions requires a file of at most n = %d, use --solutions!\n", HEX_MAX_N);
+        exit(0);
+    }
+    // The search frontier is expanded by the search engines of the flat board representation
+    if (starting_rows_calc == FRONTIER_ROW && !flat_layout){
+        printf("The search frontier requires the flat board representation, use -f1!\n");
+        exit(0);
+    }
+
+    // The remaining boards are looked up by the engines of the flat board representation, and with symmetry breaking their solutions depend on the set tiles
+    if (memo_size > 0 && (!flat_layout || symmetry || memo_size > 40)){
+        printf("Looking up the remaining boards requires the flat board representation without symmetry breaking and at most -m40, use -f1 -y0!\n");
+        exit(0);
+    }
+    memo_bits = memo_size > 0 ? memo_size : 0;
+
+    // The probes are walked by the engines of the flat board representation
+    if (estimate_probes > 0 && !flat_layout){
+        printf("Estimating the work units requires the flat board representation, use -f1!\n");
+        exit(0);
+    }
+
+    // The meet-in-the-middle solver splits the flat board and doesn't solve work units, so it can't record or report them
+    if (engine == ENGINE_MEET && !flat_layout){
+        printf("The meet-in-the-middle solver requires the flat board representation, use -f1!\n");
+        exit(0);
+    }
+    if (engine == ENGINE_MEET && (checkpoint_path != NULL || unit_stats_path != NULL)){
+        printf("Checkpoints and the results per work unit are not supported by the meet-in-the-middle solver, use -e0!\n");
+        exit(0);
+    }
+
+    // Collect the configuration of the solver
+    solver_config cfg = {
+        .n = n, .r = r, .N_s = N_s, .N = N, .M = M,
+        .find_all = find_all,
+        .precomputed_row = starting_rows_calc, .nr_s = nr_s > 0 ? nr_s : 1,
+        .parallel_exec = parallel_execution, .check_partial = check_partial, .print_solutions = print_solutions,
+        .verbosity = verbosity, .benchmark = benchmark,
+        .flat_layout = flat_layout,
+        .engine = engine,
+        .symmetry = symmetry,
+        .specialized = specialized,
+        .dynamic = dynamic, .chunk_size = chunk_size > 0 ? chunk_size : 1,
+        .task_depth = task_depth,
+        .frontier_depth = frontier_depth, .frontier_target = frontier_target,
+        .checkpoint_path = checkpoint_path, .checkpoint_interval = checkpoint_interval, .resume = resume,
+        .unit_stats_path = unit_stats_path,
+        .use_index = use_index, .index = NULL,
+        .meet_memory = (size_t)(meet_memory > 0 ? meet_memory : 0) << 20, .spill_dir = spill_dir,
+        .memo = memo_size > 0,
+        .estimate_probes = estimate_probes > 0 ? estimate_probes : 0
+    };
+
+    // The filter of the candidate values is chosen once, before any thread uses it
+    select_tile_filter();
+
+    // The index of the valid lines, which is built for every value of M the solver is called for
+    line_index index;
+    memset(&index, 0, sizeof(line_index));
+    // In parallel execution the processes of a node share one index in this window
+    node_window index_window;
+
     // If we want to execute in parallel, choose this branch
     if (parallel_execution){
         // Get the number of openMP threads
@@ -489,13 +1413,23 @@ int main(int argc, char** argv) {
         int my_rank;
         MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
 
+        // Find the processes on the same node, which share the large read-only structures
+        init_node_comm();
+        int nodes_used = count_node_groups();
+
+        // A single process has no scheduler which could keep the checkpoint
+        if (checkpoint_path != NULL && comm_sz == 1)
+            printf("Checkpoints need at least two processes in parallel execution, none is written.\n");
+
         // Print out the node name, process id and the CPU it is running on
         if (verbosity > 0){
             int cpu_num = sched_getcpu();
             char proc_name[100];
             int name_len = 0;
             MPI_Get_processor_name(proc_name, &name_len);
-            printf("Name: %s, Process: %d, CPU: %d\n",proc_name, my_rank, cpu_num);
+            printf("Name: %s, Process: %d, CPU: %d, Process on node: %d\n",proc_name, my_rank, cpu_num, node_rank());
+            if (my_rank == 0)
+                printf("The %d processes run on %d nodes.\n", comm_sz, nodes_used);
 
             MPI_Barrier(MPI_COMM_WORLD);
         }
@@ -503,37 +1437,70 @@ int main(int argc, char** argv) {
         // variables holding runtime statistics
         double diff, max_diff, min_diff, sum_diff, start_time, end_time;
         // variables holding the number of found solutions
-        int local_sol_cnt, sol_cnt, i;
+        long long local_sol_cnt, sol_cnt = 0;
+        int i;
+        // variables holding the number of placed tiles and found solutions including symmetric ones
+        solver_stats local_stats = {0, 0, 0.0};
+        long long nodes = 0, M_nodes;
+        long long sol_expanded = 0;
 
         // Print out the parameters of the solver
         if (my_rank == 0){
-            if (starting_rows_calc >= 0)
+            if (starting_rows_calc == FRONTIER_ROW)
+                printf("\nStart parallel solver with the search frontier of depth %d. We are using %d processes on %d threads.\n", frontier_depth, comm_sz, threads);
+            else if (starting_rows_calc >= 0)
                 printf("\nStart parallel solver with precomputed rows. We are using %d processes on %d threads.\n", comm_sz, threads);
             else
                 printf("\nStart parallel solver without precomputed rows. We are using %d processes on %d threads.\n", comm_sz, threads);
-            printf("n = %d, s = %d, M = %d, a = %d, l = %d\n\n", n, N_s, M, find_all, nr_s);
+            printf("n = %d, s = %d, M = %d, a = %d, l = %d, f = %d, e = %d, y = %d, d = %d, k = %d, t = %d, u = %d, g = %d, x = %d, i = %d\n\n", n, N_s, M, find_all, nr_s, flat_layout, engine, symmetry, dynamic, chunk_size, task_depth, frontier_depth, frontier_target, specialized, use_index);
         }
 
+        // Every process writes the solutions it finds on its own
+        if (print_solutions)
+            open_solution_sink(solutions_path, my_rank, comm_sz);
+
         // Wait for all processes to reach this point and start the timer
         MPI_Barrier(MPI_COMM_WORLD);
         start_time = MPI_Wtime();
 
         // Call the solver dependent on which benchmark we are running
         if (benchmark == 1 || benchmark == 3){
-            local_sol_cnt = solver(n, r, N_s, N, M, find_all, starting_rows_calc, nr_s, parallel_execution, check_partial, print_solutions, verbosity, benchmark);
+            prepare_line_index(&cfg, &index, &index_window, my_rank == 0);
+            local_sol_cnt = solver(&cfg, &local_stats);
+            release_line_index(&cfg, &index, &index_window);
      
-            // Add up number of found solutions
-            MPI_Reduce(&local_sol_cnt, &sol_cnt, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+            // Add up number of found solutions and placed tiles
+            MPI_Reduce(&local_sol_cnt, &sol_cnt, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&local_stats.sol_expanded, &sol_expanded, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+            MPI_Reduce(&local_stats.nodes, &nodes, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
         }
         else if (benchmark == 2){
+            // Only one value of M can have solutions, so the solver is only called for it
+            int feasible_M = feasible_line_sum(n, N_s);
+            if (my_rank == 0 && feasible_M > 0)
+                printf("The values add up to %d lines of M = %d, all other values of M are skipped.\n", r, feasible_M);
+            else if (my_rank == 0)
+                printf("The values can't be split into %d lines of equal sum, all values of M are skipped.\n", r);
             // Loop over a range of possible values of M and call the solver for each of them
             for (i = 19; i <= 54; i++){
-                local_sol_cnt = solver(n, r, N_s, N, i, find_all, starting_rows_calc, nr_s, parallel_execution, check_partial, print_solutions, verbosity, benchmark);
+                if (i != feasible_M){
+                    if (my_rank == 0)
+                        printf("M = %d, sol_cnt = 0, skipped\n", i);
+                    continue;
+                }
+                cfg.M = i;
+                local_stats.nodes = 0;
+                prepare_line_index(&cfg, &index, &index_window, my_rank == 0);
+                local_sol_cnt = solver(&cfg, &local_stats);
+                release_line_index(&cfg, &index, &index_window);
 
-                // Add up number of found solutions
-                MPI_Reduce(&local_sol_cnt, &sol_cnt, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-                if (my_rank == 0)
-                    printf("M = %d, sol_cnt = %d\n", i, sol_cnt);
+                // Add up number of found solutions and placed tiles
+                MPI_Reduce(&local_sol_cnt, &sol_cnt, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+                MPI_Reduce(&local_stats.nodes, &M_nodes, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+                if (my_rank == 0){
+                    printf("M = %d, sol_cnt = %lld, nodes = %lld\n", i, sol_cnt, M_nodes);
+                    nodes += M_nodes;
+                }
             }
         }
         else{
@@ -541,25 +1508,66 @@ int main(int argc, char** argv) {
             exit(0);
         }
 
-        // Stop the timer
+        // Write the solutions left in the buffers and stop the timer
+        close_solution_sink();
         end_time = MPI_Wtime();
 
+        // Add up the search statistics of all threads and processes
+        #ifdef HEX_STATS
+            search_stats local_search_stats = {0}, total_search_stats;
+            collect_search_stats(&local_search_stats);
+            reduce_search_stats(&local_search_stats, &total_search_stats);
+        #endif
+        // Add up the look ups of the remaining boards of all threads and processes
+        long long local_memo[2] = {0, 0}, memo[2];
+        if (memo_size > 0){
+            collect_memo_stats(&local_memo[0], &local_memo[1]);
+            MPI_Reduce(local_memo, memo, 2, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+        }
+
         // Calculate the runtime statistics
         diff = end_time - start_time;
         MPI_Reduce(&diff, &max_diff, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
         MPI_Reduce(&diff, &min_diff, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
         MPI_Reduce(&diff, &sum_diff, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        // Collect the time each process spent solving
+        double busy[comm_sz];
+        MPI_Gather(&local_stats.busy, 1, MPI_DOUBLE, busy, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
         // Print out the runtime statistics and number of found solutions
         if (my_rank == 0){
             if (benchmark != 2){
-                printf("The solver found %d solutions.\n", sol_cnt);
+                printf("The solver found %lld solutions.\n", sol_cnt);
+                if (symmetry)
+                    printf("These are %lld solutions including all rotations and reflections.\n", sol_expanded);
             }
+            if (flat_layout)
+                printf("The search engine %d expanded %lld nodes.\n", engine, nodes);
             printf("This took %lf seconds on %d processes.\n", max_diff, comm_sz);
-            printf("The shortest running process was %lf seconds long and on average a process took %lf seconds (total = %lf).", min_diff, sum_diff / comm_sz, sum_diff);
+            printf("The shortest running process was %lf seconds long and on average a process took %lf seconds (total = %lf).\n", min_diff, sum_diff / comm_sz, sum_diff);
+            // A process is idle whenever it isn't solving until the slowest process is done
+            for (i = 0; i < comm_sz; i++){
+                if (dynamic && comm_sz > 1 && i == 0)
+                    printf("Process %d scheduled the work units for %lf seconds.\n", i, max_diff);
+                else
+                    printf("Process %d was busy for %lf seconds and idle for %lf seconds.\n", i, busy[i], max_diff - busy[i]);
+            }
+            if (memo_size > 0)
+                print_memo_stats(memo[0], memo[1]);
+            #ifdef HEX_STATS
+                print_search_stats(&total_search_stats);
+            #endif
+        }
+
+        // The first process merges the solutions of all processes once they are written
+        if (dedup){
+            MPI_Barrier(MPI_COMM_WORLD);
+            if (my_rank == 0)
+                write_distinct_solutions(solutions_path, n, comm_sz);
         }
 
         // Finalize the MPI environment
+        free_node_comm();
         MPI_Finalize();
     }
     // Sequential execution
@@ -568,28 +1576,52 @@ int main(int argc, char** argv) {
         struct timespec start_time, end_time;
         double diff;
         // variables holding the number of found solutions
-        int sol_cnt, i;
-        
+        long long sol_cnt = 0;
+        int i;
+        // variables holding the number of placed tiles and found solutions including symmetric ones
+        solver_stats stats = {0, 0, 0.0};
+
         // Print out the parameters of the solver
-        if (starting_rows_calc >= 0)
+        if (starting_rows_calc == FRONTIER_ROW)
+            printf("\nStart sequential solver with the search frontier of depth %d.\n", frontier_depth);
+        else if (starting_rows_calc >= 0)
             printf("\nStart sequential solver with precomputed rows.\n");
         else
             printf("\nStart sequential solver without precomputed rows.\n");
-        printf("n = %d, s = %d, M = %d, a = %d, l = %d\n\n", n, N_s, M, find_all, nr_s);
+        printf("n = %d, s = %d, M = %d, a = %d, l = %d, f = %d, e = %d, y = %d, u = %d, g = %d, x = %d, i = %d\n\n", n, N_s, M, find_all, nr_s, flat_layout, engine, symmetry, frontier_depth, frontier_target, specialized, use_index);
+
+        if (print_solutions)
+            open_solution_sink(solutions_path, 0, 1);
 
         // Start the timer
         clock_gettime(CLOCK_MONOTONIC, &start_time);
 
         // Call the solver dependent on which benchmark we are running
         if (benchmark == 1 || benchmark == 3){
-            sol_cnt = solver(n, r, N_s, N, M, find_all, starting_rows_calc, nr_s, parallel_execution, check_partial, print_solutions, verbosity, benchmark);
+            prepare_line_index(&cfg, &index, NULL, true);
+            sol_cnt = solver(&cfg, &stats);
+            release_line_index(&cfg, &index, NULL);
         }
         else if (benchmark == 2){
+            // Only one value of M can have solutions, so the solver is only called for it
+            int feasible_M = feasible_line_sum(n, N_s);
+            if (feasible_M > 0)
+                printf("The values add up to %d lines of M = %d, all other values of M are skipped.\n", r, feasible_M);
+            else
+                printf("The values can't be split into %d lines of equal sum, all values of M are skipped.\n", r);
             // Loop over a range of possible values of M and call the solver for each of them
             for (i = 19; i <= 54; i++){
-                sol_cnt = solver(n, r, N_s, N, i, find_all, starting_rows_calc, nr_s, parallel_execution, check_partial, print_solutions, verbosity, benchmark);
+                if (i != feasible_M){
+                    printf("M = %d, sol_cnt = 0, skipped\n", i);
+                    continue;
+                }
+                cfg.M = i;
+                long long M_nodes = stats.nodes;
+                prepare_line_index(&cfg, &index, NULL, true);
+                sol_cnt = solver(&cfg, &stats);
+                release_line_index(&cfg, &index, NULL);
 
-                printf("M = %d, sol_cnt = %d\n", i, sol_cnt);
+                printf("M = %d, sol_cnt = %lld, nodes = %lld\n", i, sol_cnt, stats.nodes - M_nodes);
             }
         }
         else{
@@ -597,13 +1629,30 @@ int main(int argc, char** argv) {
             exit(0);
         }
 
-        // Stop the timer
+        // Write the solutions left in the buffers and stop the timer
+        close_solution_sink();
         clock_gettime(CLOCK_MONOTONIC, &end_time);
 
         // Print out the number of found solutions and the runtime
-        printf("The solver found %d solutions.\n", sol_cnt);
+        printf("The solver found %lld solutions.\n", sol_cnt);
+        if (symmetry)
+            printf("These are %lld solutions including all rotations and reflections.\n", stats.sol_expanded);
+        if (flat_layout)
+            printf("The search engine %d expanded %lld nodes.\n", engine, stats.nodes);
         diff = get_time_diff(start_time, end_time);
         printf("This took %lf seconds.\n", diff);
+        if (memo_size > 0){
+            long long hits = 0, misses = 0;
+            collect_memo_stats(&hits, &misses);
+            print_memo_stats(hits, misses);
+        }
+        #ifdef HEX_STATS
+            search_stats totals = {0};
+            collect_search_stats(&totals);
+            print_search_stats(&totals);
+        #endif
+        if (dedup)
+            write_distinct_solutions(solutions_path, n, 1);
     }
 
     return 0;
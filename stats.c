@@ -0,0 +1,89 @@
+/*Here you can find the statistics of the work done by the search engines, which allow to compare pruning strategies by the number of nodes instead of the runtime.
+The counters are only updated if the solver is compiled with -DHEX_STATS, otherwise the engines don't touch them and all counts stay 0.
+Each thread counts on its own copy, so the hot path never synchronizes. The copies are added up once the search is over and then summed over all processes.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <mpi.h>
+
+#include "stats.h"
+
+#ifdef HEX_STATS
+    search_stats thread_stats;
+#endif
+
+void collect_search_stats(search_stats *total){
+    /* This function adds the counters of all threads to total and resets them.
+    The threads of the search are the ones of the default team, so a parallel region with the same number of threads visits all their copies.
+    */
+    #ifdef HEX_STATS
+        #ifdef _OPENMP
+            #pragma omp parallel
+        #endif
+        {
+            int k;
+            #ifdef _OPENMP
+                #pragma omp critical(search_stats)
+            #endif
+            {
+                for (k = 0; k <= STATS_MAX_DEPTH; k++){
+                    total->nodes[k] += thread_stats.nodes[k];
+                }
+                for (k = 0; k < PRUNE_REASONS; k++){
+                    total->prunes[k] += thread_stats.prunes[k];
+                }
+                total->leaves += thread_stats.leaves;
+            }
+            memset(&thread_stats, 0, sizeof(search_stats));
+        }
+    #else
+        (void)total;
+    #endif
+}
+
+void restore_search_stats(const search_stats *saved){
+    /* This function adds counters taken by collect_search_stats back to the ones of the calling thread.
+    Only the sum over all threads is reported, so it doesn't matter which thread holds them.
+    */
+    #ifdef HEX_STATS
+        int k;
+        for (k = 0; k <= STATS_MAX_DEPTH; k++){
+            thread_stats.nodes[k] += saved->nodes[k];
+        }
+        for (k = 0; k < PRUNE_REASONS; k++){
+            thread_stats.prunes[k] += saved->prunes[k];
+        }
+        thread_stats.leaves += saved->leaves;
+    #else
+        (void)saved;
+    #endif
+}
+
+void reduce_search_stats(const search_stats *local, search_stats *total){
+    /* This function adds up the counters of all processes on the first process.
+    The counters are stored one after another, so they are reduced at once.
+    */
+    MPI_Reduce(local, total, sizeof(search_stats) / sizeof(long long), MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+}
+
+void print_search_stats(const search_stats *stats){
+    /* This function prints the nodes of every depth which has any, the pruned values by reason and the number of leaves.
+    */
+    int k;
+    long long nodes = 0, prunes = 0;
+    printf("Search statistics:\n");
+    for (k = 0; k <= STATS_MAX_DEPTH; k++){
+        if (stats->nodes[k] == 0)
+            continue;
+        printf("Depth %d%s: %lld nodes\n", k, k == STATS_MAX_DEPTH ? " and deeper" : "", stats->nodes[k]);
+        nodes += stats->nodes[k];
+    }
+    for (k = 0; k < PRUNE_REASONS; k++){
+        prunes += stats->prunes[k];
+    }
+    printf("Nodes: %lld, leaves: %lld\n", nodes, stats->leaves);
+    printf("Pruned values: %lld used, %lld line sum out of reach, %lld complete line wrong, %lld not canonical\n", stats->prunes[PRUNE_VALUE_USED], stats->prunes[PRUNE_SUM_BOUND], stats->prunes[PRUNE_LINE_WRONG], stats->prunes[PRUNE_SYMMETRY]);
+    if (nodes + prunes > 0)
+        printf("%lf%% of the values considered at a tile were pruned.\n", 100.0 * prunes / (nodes + prunes));
+}
@@ -0,0 +1,50 @@
+#ifndef STATS_H
+#define STATS_H
+
+// Deepest level the statistics are kept for separately, deeper levels are added to the last one
+#define STATS_MAX_DEPTH 128
+
+// The reasons why a value is not tried at an empty tile
+enum {
+    // The value is already placed on another tile
+    PRUNE_VALUE_USED,
+    // A line of the tile would exceed M or could no longer reach it with the remaining values
+    PRUNE_SUM_BOUND,
+    // The tile is the last empty one of a line, which would be complete with a sum other than M
+    PRUNE_LINE_WRONG,
+    // The board would not be the canonical one of its rotations and reflections
+    PRUNE_SYMMETRY,
+    PRUNE_REASONS
+};
+
+// Counters of the work done by the search engines, which are only updated if compiled with -DHEX_STATS.
+// A node at depth d is a value tried at a tile while d - 1 tiles are set, a leaf is a board with all tiles set.
+typedef struct {
+    long long nodes[STATS_MAX_DEPTH + 1];
+    long long prunes[PRUNE_REASONS];
+    long long leaves;
+} search_stats;
+
+#ifdef HEX_STATS
+    // Every thread counts on its own copy, collect_search_stats adds them up
+    extern search_stats thread_stats;
+    #ifdef _OPENMP
+        #pragma omp threadprivate(thread_stats)
+    #endif
+
+    static inline void count_nodes(int depth, long long cnt){
+        /* This function counts cnt nodes at the given depth.
+        */
+        thread_stats.nodes[depth < STATS_MAX_DEPTH ? depth : STATS_MAX_DEPTH] += cnt;
+    }
+#endif
+
+void collect_search_stats(search_stats *total);
+
+void restore_search_stats(const search_stats *saved);
+
+void reduce_search_stats(const search_stats *local, search_stats *total);
+
+void print_search_stats(const search_stats *stats);
+
+#endif
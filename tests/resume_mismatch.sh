@@ -0,0 +1,40 @@
+#!/bin/bash
+# Checks that resuming from a checkpoint written with other parameters is refused and leaves the checkpoint byte-identical.
+# Run it from the directory of the sources once the solver is built as in the README:
+#   tests/resume_mismatch.sh [solver]
+# If MPIEXEC is set, e.g. to "mpiexec -n 3", the parallel solver with the dynamic distribution is checked as well.
+
+SOLVER=${1:-./solver.o}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+FAILED=0
+
+check(){
+    # $1 names the case, $2 starts the solver, the other arguments select the distribution
+    local name=$1 run=$2
+    shift 2
+    local cp="$DIR/$name.txt"
+    # Write a checkpoint without the index of the valid lines
+    if ! $run "$SOLVER" -n 3 -M 38 -a 1 -r0 -l1 -i0 "$@" --checkpoint "$cp" > "$DIR/$name.write.log" 2>&1 || [ ! -s "$cp" ]; then
+        echo "FAIL $name: the checkpoint was not written"
+        FAILED=1
+        return
+    fi
+    cp "$cp" "$DIR/$name.saved"
+    # Resuming with the index has to fail without touching the checkpoint
+    if $run "$SOLVER" -n 3 -M 38 -a 1 -r0 -l1 -i1 "$@" --checkpoint "$cp" --resume > "$DIR/$name.resume.log" 2>&1; then
+        echo "FAIL $name: resuming with other parameters succeeded"
+        FAILED=1
+    elif ! cmp -s "$cp" "$DIR/$name.saved"; then
+        echo "FAIL $name: the checkpoint was changed"
+        FAILED=1
+    else
+        echo "PASS $name"
+    fi
+}
+
+check sequential "" -p0
+if [ -n "${MPIEXEC:-}" ]; then
+    check parallel "$MPIEXEC" -p1 -d1
+fi
+exit $FAILED
@@ -0,0 +1,51 @@
+#ifndef VALSET_H
+#define VALSET_H
+
+#include <stdint.h>
+
+// A set of values stored as a bitmask, where bit k stands for the value k + N_s.
+// By default 64 values fit into the set, compile with -DHEX_WIDE_VALUES to allow up to 128 values (n <= 7).
+#ifdef HEX_WIDE_VALUES
+    typedef unsigned __int128 valset_t;
+    #define VALSET_BITS 128
+#else
+    typedef uint64_t valset_t;
+    #define VALSET_BITS 64
+#endif
+
+static inline int valset_first(valset_t set){
+    /* This function returns the smallest value index in a non-empty set.
+    */
+    #ifdef HEX_WIDE_VALUES
+        uint64_t low = (uint64_t)set;
+        if (low)
+            return __builtin_ctzll(low);
+        return 64 + __builtin_ctzll((uint64_t)(set >> 64));
+    #else
+        return __builtin_ctzll(set);
+    #endif
+}
+
+static inline int valset_count(valset_t set){
+    /* This function returns the number of values in the set.
+    */
+    #ifdef HEX_WIDE_VALUES
+        return __builtin_popcountll((uint64_t)set) + __builtin_popcountll((uint64_t)(set >> 64));
+    #else
+        return __builtin_popcountll(set);
+    #endif
+}
+
+static inline valset_t valset_range(int lo, int hi){
+    /* This function returns the set of all value indexes from lo to hi (both included).
+    */
+    if (lo < 0)
+        lo = 0;
+    if (hi > VALSET_BITS - 1)
+        hi = VALSET_BITS - 1;
+    if (lo > hi)
+        return 0;
+    return (~(valset_t)0 >> (VALSET_BITS - 1 - hi)) & (~(valset_t)0 << lo);
+}
+
+#endif